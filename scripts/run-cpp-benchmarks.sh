@@ -0,0 +1,6 @@
+#!/bin/bash
+# Expects a Release build configured with -DWITH_BENCHMARKS=ON, e.g.
+#   mkdir -p build/cmake-makefile-release && cd build/cmake-makefile-release
+#   cmake -DCMAKE_BUILD_TYPE=Release -DWITH_BENCHMARKS=ON ../.. && cmake --build . --target polars_cpp_bench
+# Extra arguments are passed on, e.g. --benchmark_filter=BM_rolling_mean
+build/cmake-makefile-release/polars_cpp_bench --benchmark_out=polars_cpp_bench.json --benchmark_out_format=json "$@"
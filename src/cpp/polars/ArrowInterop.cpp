@@ -0,0 +1,500 @@
+#include "ArrowInterop.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace polars {
+
+    namespace arrow {
+
+        namespace {
+
+            // Pointed at by the buffers of empty arrays, which Arrow prefers not to be null.
+            const double empty_buffer[1] = {0};
+
+            std::int64_t gcd(std::int64_t a, std::int64_t b) {
+                while (b != 0) {
+                    std::int64_t r = a % b;
+                    a = b;
+                    b = r;
+                }
+                return a;
+            }
+
+            std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+                std::int64_t q = a / b;
+                return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+            }
+
+            // Ticks per second of an Arrow timestamp format, "ts" then s, m, u or n and ":" and a time zone, or 0.
+            std::int64_t timestamp_ticks_per_second(const char *format) {
+                if (std::strncmp(format, "ts", 2) != 0 || format[2] == '\0' || format[3] != ':') {
+                    return 0;
+                }
+                switch (format[2]) {
+                    case 's': return 1;
+                    case 'm': return 1000;
+                    case 'u': return 1000000;
+                    case 'n': return 1000000000;
+                    default: return 0;
+                }
+            }
+
+
+            // Owns an imported array, releasing it once the last vector over its buffers has gone.
+            struct ImportedArray {
+                ArrowArray array;
+
+                ~ImportedArray() {
+                    if (array.release) {
+                        array.release(&array);
+                    }
+                }
+            };
+
+            struct ImportedSchema {
+                ArrowSchema schema;
+
+                ~ImportedSchema() {
+                    if (schema.release) {
+                        schema.release(&schema);
+                    }
+                }
+            };
+
+            // A child of the imported struct array, with the struct's offset applied.
+            struct Column {
+                const ArrowSchema *schema;
+                const ArrowArray *array;
+                arma::uword offset;
+                arma::uword length;
+
+                const std::uint8_t *validity() const {
+                    return array->null_count == 0 ? nullptr : static_cast<const std::uint8_t *>(array->buffers[0]);
+                }
+
+                const void *data() const {
+                    return array->buffers[1];
+                }
+            };
+
+            struct ImportedStruct {
+                std::shared_ptr<ImportedArray> array;
+                std::unique_ptr<ImportedSchema> schema;
+                // The index first, then the values.
+                std::vector<Column> columns;
+            };
+
+            // Take over a struct array and its schema, moving them as the specification describes.
+            ImportedStruct import_struct(ArrowArray *array, ArrowSchema *schema, const std::string &caller) {
+                if (!array || !array->release || !schema || !schema->release) {
+                    throw std::invalid_argument(caller + ": the array or schema is missing or released");
+                }
+                ImportedStruct imported;
+                imported.array = std::make_shared<ImportedArray>();
+                imported.array->array = *array;
+                array->release = nullptr;
+                imported.schema.reset(new ImportedSchema());
+                imported.schema->schema = *schema;
+                schema->release = nullptr;
+
+                const ArrowArray &parent = imported.array->array;
+                const ArrowSchema &parentSchema = imported.schema->schema;
+                if (std::strcmp(parentSchema.format, "+s") != 0 || parentSchema.n_children < 1 ||
+                    parent.n_children != parentSchema.n_children) {
+                    throw std::invalid_argument(caller + ": expected a struct array of an index and values");
+                }
+                if (parent.null_count != 0 && parent.buffers[0] &&
+                    BitMask(static_cast<const std::uint8_t *>(parent.buffers[0]), parent.offset, parent.length)
+                            .count() != static_cast<arma::uword>(parent.length)) {
+                    throw std::invalid_argument(caller + ": null rows of the struct array are not supported");
+                }
+
+                arma::uword indexChild = 0;
+                for (arma::uword i = 0; i < static_cast<arma::uword>(parentSchema.n_children); i++) {
+                    const char *name = parentSchema.children[i]->name;
+                    if (name && std::strcmp(name, "index") == 0) {
+                        indexChild = i;
+                        break;
+                    }
+                }
+                auto column = [&](arma::uword i) {
+                    const ArrowArray *child = parent.children[i];
+                    if (child->n_buffers != 2) {
+                        throw std::invalid_argument(caller + ": unsupported format " +
+                                                    parentSchema.children[i]->format);
+                    }
+                    return Column{parentSchema.children[i], child,
+                                  static_cast<arma::uword>(child->offset + parent.offset),
+                                  static_cast<arma::uword>(parent.length)};
+                };
+                imported.columns.push_back(column(indexChild));
+                for (arma::uword i = 0; i < static_cast<arma::uword>(parentSchema.n_children); i++) {
+                    if (i != indexChild) {
+                        imported.columns.push_back(column(i));
+                    }
+                }
+                return imported;
+            }
+
+            template<class T>
+            arma::vec convert(const void *data, arma::uword offset, arma::uword length) {
+                const T *in = static_cast<const T *>(data) + offset;
+                arma::vec result(length);
+                for (arma::uword i = 0; i < length; i++) {
+                    result[i] = static_cast<double>(in[i]);
+                }
+                return result;
+            }
+
+            // Whether values is a vector over the column's Arrow buffer rather than a converted copy.
+            bool wraps(const arma::vec &values, const Column &column) {
+                const double *data = static_cast<const double *>(column.data()) + column.offset;
+                return values.n_elem > 0 && values.memptr() == data;
+            }
+
+            /**
+             * The column as doubles: over its Arrow buffer when that holds aligned float64s, otherwise converted.
+             */
+            arma::vec column_values(const Column &column, const std::string &caller) {
+                const char *format = column.schema->format;
+                arma::uword n = column.length;
+                if (n == 0) {
+                    return arma::vec();
+                }
+
+                if (std::strcmp(format, "g") == 0) {
+                    const double *data = static_cast<const double *>(column.data()) + column.offset;
+                    if (reinterpret_cast<std::uintptr_t>(data) % alignof(double) != 0) {
+                        arma::vec copy(n);
+                        std::memcpy(copy.memptr(), data, n * sizeof(double));
+                        return copy;
+                    }
+                    // Not strict, so that moving the vector hands over the pointer rather than copying.
+                    return arma::vec(const_cast<double *>(data), n, false, false);
+                }
+                if (std::strcmp(format, "f") == 0) {
+                    return convert<float>(column.data(), column.offset, n);
+                }
+                if (std::strcmp(format, "l") == 0) {
+                    return convert<std::int64_t>(column.data(), column.offset, n);
+                }
+                if (std::strcmp(format, "i") == 0) {
+                    return convert<std::int32_t>(column.data(), column.offset, n);
+                }
+
+                if (timestamp_ticks_per_second(format) == 0) {
+                    throw std::invalid_argument(caller + ": unsupported format " + format);
+                }
+                return convert<std::int64_t>(column.data(), column.offset, n);
+            }
+
+            /**
+             * Timestamps, or int64s taken to hold them already, as exact ticks of period, rounding down. Ticks in the
+             * Arrow unit are used over its buffer; others are converted, throwing if a count overflows an int64.
+             */
+            SharedIndex import_ticks(const Column &column, std::int64_t perSecond, Period period,
+                                     std::shared_ptr<ImportedArray> owner, const std::string &caller) {
+                arma::uword n = column.length;
+                if (n == 0) {
+                    return SharedIndex::from_ticks({});
+                }
+                // ticks * den / (perSecond * num), reduced first so that the usual units multiply or divide by one.
+                std::int64_t multiplier = 1;
+                std::int64_t divisor = 1;
+                if (perSecond != 0) {
+                    multiplier = period.den;
+                    divisor = perSecond * period.num;
+                    std::int64_t common = gcd(multiplier, divisor);
+                    multiplier /= common;
+                    divisor /= common;
+                }
+                const std::int64_t *ticks = static_cast<const std::int64_t *>(column.data()) + column.offset;
+                if (multiplier == 1 && divisor == 1 &&
+                    reinterpret_cast<std::uintptr_t>(ticks) % alignof(std::int64_t) == 0) {
+                    return SharedIndex::adopt_ticks(std::shared_ptr<const std::int64_t>(std::move(owner), ticks), n);
+                }
+                std::vector<std::int64_t> converted(n);
+                for (arma::uword i = 0; i < n; i++) {
+                    std::int64_t tick;
+                    std::memcpy(&tick, ticks + i, sizeof(tick));
+                    if (__builtin_mul_overflow(tick, multiplier, &tick)) {
+                        throw std::invalid_argument(caller + ": timestamp at row " + std::to_string(i) +
+                                                    " overflows the time points' ticks");
+                    }
+                    converted[i] = floor_div(tick, divisor);
+                }
+                return SharedIndex::from_ticks(std::move(converted));
+            }
+
+            // The validity of a column, all set when it has no validity bitmap.
+            BitMask column_validity(const Column &column) {
+                const std::uint8_t *validity = column.validity();
+                return validity ? BitMask(validity, column.offset, column.length) : ~BitMask(column.length);
+            }
+
+            arma::vec values_with_nans(const Column &column, const std::string &caller) {
+                arma::vec values = column_values(column, caller);
+                if (!column.validity()) {
+                    return values;
+                }
+                BitMask valid = column_validity(column);
+                if (valid.count() == column.length) {
+                    return values;
+                }
+                // Never write into Arrow's buffer, which assigning to a vector over it could do.
+                arma::vec result = wraps(values, column) ? arma::vec(values.memptr(), values.n_elem)
+                                                         : std::move(values);
+                for (arma::uword i = 0; i < column.length; i++) {
+                    if (!valid[i]) {
+                        result[i] = NAN;
+                    }
+                }
+                return result;
+            }
+
+            SharedIndex import_index(const ImportedStruct &imported, Period period, const std::string &caller) {
+                const Column &column = imported.columns.front();
+                if (column.validity() && column_validity(column).count() != column.length) {
+                    throw std::invalid_argument(caller + ": the index has nulls");
+                }
+                // The index holds the array, so every Series wrapping its buffers keeps it alive.
+                std::shared_ptr<ImportedArray> owner = imported.array;
+                const char *format = column.schema->format;
+                std::int64_t perSecond = timestamp_ticks_per_second(format);
+                if (period.num != 0 && (perSecond != 0 || std::strcmp(format, "l") == 0)) {
+                    return import_ticks(column, perSecond, period, std::move(owner), caller);
+                }
+                std::shared_ptr<const arma::vec> index(new arma::vec(column_values(column, caller)),
+                                                       [owner](const arma::vec *vec) { delete vec; });
+                return SharedIndex::adopt(std::move(index));
+            }
+
+
+            // Everything exported arrays point into, shared by the struct array and its children, which consumers
+            // may move out and release separately.
+            struct ExportedData {
+                Series series;
+                DataFrame frame;
+                std::vector<std::int64_t> timestamps;
+            };
+
+            struct ExportedArray {
+                std::shared_ptr<ExportedData> data;
+                const void *buffers[2];
+                std::vector<ArrowArray> children;
+                std::vector<ArrowArray *> childPointers;
+            };
+
+            struct ExportedSchema {
+                std::string format;
+                std::string name;
+                std::vector<ArrowSchema> children;
+                std::vector<ArrowSchema *> childPointers;
+            };
+
+            void release_array(ArrowArray *array) {
+                auto exported = static_cast<ExportedArray *>(array->private_data);
+                for (ArrowArray *child : exported->childPointers) {
+                    if (child->release) {
+                        child->release(child);
+                    }
+                }
+                delete exported;
+                array->release = nullptr;
+            }
+
+            void release_schema(ArrowSchema *schema) {
+                auto exported = static_cast<ExportedSchema *>(schema->private_data);
+                for (ArrowSchema *child : exported->childPointers) {
+                    if (child->release) {
+                        child->release(child);
+                    }
+                }
+                delete exported;
+                schema->release = nullptr;
+            }
+
+            ArrowArray make_array(ExportedArray *exported, arma::uword length, std::int64_t n_buffers) {
+                ArrowArray array;
+                array.length = length;
+                array.null_count = 0;
+                array.offset = 0;
+                array.n_buffers = n_buffers;
+                array.n_children = exported->childPointers.size();
+                array.buffers = exported->buffers;
+                array.children = exported->childPointers.empty() ? nullptr : exported->childPointers.data();
+                array.dictionary = nullptr;
+                array.release = release_array;
+                array.private_data = exported;
+                return array;
+            }
+
+            ArrowSchema make_schema(ExportedSchema *exported, std::int64_t flags) {
+                ArrowSchema schema;
+                schema.format = exported->format.c_str();
+                schema.name = exported->name.c_str();
+                schema.metadata = nullptr;
+                schema.flags = flags;
+                schema.n_children = exported->childPointers.size();
+                schema.children = exported->childPointers.empty() ? nullptr : exported->childPointers.data();
+                schema.dictionary = nullptr;
+                schema.release = release_schema;
+                schema.private_data = exported;
+                return schema;
+            }
+
+            struct ExportedColumn {
+                std::string name;
+                std::string format;
+                const void *buffer;
+                std::int64_t flags;
+            };
+
+            // Export a struct array of columns, all pointing into data, into array and schema.
+            void export_struct(std::shared_ptr<ExportedData> data, arma::uword length,
+                               const std::vector<ExportedColumn> &columns, ArrowArray *array, ArrowSchema *schema) {
+                std::unique_ptr<ExportedArray> parent(new ExportedArray{data, {nullptr, nullptr}, {}, {}});
+                std::unique_ptr<ExportedSchema> parentSchema(new ExportedSchema{"+s", "", {}, {}});
+                parent->children.reserve(columns.size());
+                parentSchema->children.reserve(columns.size());
+
+                for (const ExportedColumn &column : columns) {
+                    auto child = new ExportedArray{data, {nullptr, length ? column.buffer : empty_buffer}, {}, {}};
+                    parent->children.push_back(make_array(child, length, 2));
+                    parent->childPointers.push_back(&parent->children.back());
+
+                    auto childSchema = new ExportedSchema{column.format, column.name, {}, {}};
+                    parentSchema->children.push_back(make_schema(childSchema, column.flags));
+                    parentSchema->childPointers.push_back(&parentSchema->children.back());
+                }
+
+                *array = make_array(parent.release(), length, 1);
+                *schema = make_schema(parentSchema.release(), 0);
+            }
+
+        }  // namespace
+
+
+        Series import_series(ArrowArray *array, ArrowSchema *schema, SeriesMask *valid, Period period) {
+            const std::string caller = "import_arrow";
+            ImportedStruct imported = import_struct(array, schema, caller);
+            if (imported.columns.size() != 2) {
+                throw std::invalid_argument(caller + ": expected a struct array of an index and values");
+            }
+            SharedIndex index = import_index(imported, period, caller);
+
+            const Column &column = imported.columns[1];
+            if (!valid) {
+                return Series(values_with_nans(column, caller), index);
+            }
+            *valid = SeriesMask(column_validity(column), index);
+            return Series(column_values(column, caller), index);
+        }
+
+
+        void export_series(Series series, ArrowArray *array, ArrowSchema *schema, Period period,
+                           const std::string &timezone) {
+            std::shared_ptr<ExportedData> data = std::make_shared<ExportedData>();
+            data->series = std::move(series);
+            const Series &exported = data->series;
+
+            ExportedColumn index{"index", "g", nullptr, 0};
+            if (period.num == 0) {
+                index.buffer = exported.index().memptr();
+            } else {
+                // The finest unit needed to count the period's ticks in whole numbers.
+                const char units[] = {'s', 'm', 'u', 'n'};
+                std::int64_t perSecond = 1;
+                arma::uword unit = 0;
+                while (unit < 4 && (perSecond * period.num) % period.den != 0) {
+                    perSecond *= 1000;
+                    unit++;
+                }
+                if (unit == 4) {
+                    throw std::invalid_argument("export_arrow: the time points' period has no Arrow timestamp unit");
+                }
+                std::int64_t multiplier = perSecond * period.num / period.den;
+                index.format = std::string("ts") + units[unit] + ":" + timezone;
+
+                // The exact ticks of a TimeSeries rather than its labels, which are rounded beyond 2^53.
+                const SharedIndex &labels = exported.shared_index();
+                const std::int64_t *ticks = labels.has_ticks() ? labels.ticks() : nullptr;
+                if (ticks && multiplier == 1) {
+                    index.buffer = ticks;
+                } else {
+                    data->timestamps.resize(exported.size());
+                    for (arma::uword i = 0; i < exported.size(); i++) {
+                        std::int64_t tick;
+                        if (ticks) {
+                            tick = ticks[i];
+                        } else {
+                            double label = exported.index()[i];
+                            if (!(std::isfinite(label) && label >= -9223372036854775808.0 &&
+                                  label < 9223372036854775808.0)) {
+                                throw std::invalid_argument("export_arrow: timestamp at row " + std::to_string(i) +
+                                                            " is not a finite tick count");
+                            }
+                            tick = std::llround(label);
+                        }
+                        if (__builtin_mul_overflow(tick, multiplier, &data->timestamps[i])) {
+                            throw std::invalid_argument("export_arrow: timestamp at row " + std::to_string(i) +
+                                                        " overflows the Arrow unit");
+                        }
+                    }
+                    index.buffer = data->timestamps.data();
+                }
+            }
+
+            export_struct(data, exported.size(),
+                          {index, {"value", "g", exported.values().memptr(), ARROW_FLAG_NULLABLE}}, array, schema);
+        }
+
+    }  // arrow
+
+
+    Series import_arrow(ArrowArray *array, ArrowSchema *schema, SeriesMask *valid) {
+        return arrow::import_series(array, schema, valid, {0, 1});
+    }
+
+
+    DataFrame import_arrow_dataframe(ArrowArray *array, ArrowSchema *schema) {
+        const std::string caller = "import_arrow_dataframe";
+        arrow::ImportedStruct imported = arrow::import_struct(array, schema, caller);
+        SharedIndex index = arrow::import_index(imported, {0, 1}, caller);
+
+        DataFrame df(index);
+        for (arma::uword i = 1; i < imported.columns.size(); i++) {
+            const arrow::Column &column = imported.columns[i];
+            std::string name = column.schema->name ? column.schema->name : "";
+            df.add_column(name, Series(arrow::values_with_nans(column, caller), index));
+        }
+        return df;
+    }
+
+
+    void export_arrow(Series series, ArrowArray *array, ArrowSchema *schema) {
+        arrow::export_series(std::move(series), array, schema, {0, 1}, "");
+    }
+
+
+    void export_arrow(DataFrame df, ArrowArray *array, ArrowSchema *schema) {
+        std::shared_ptr<arrow::ExportedData> data = std::make_shared<arrow::ExportedData>();
+        data->frame = std::move(df);
+        const DataFrame &exported = data->frame;
+
+        std::vector<arrow::ExportedColumn> columns = {{"index", "g", exported.index().memptr(), 0}};
+        for (const std::string &name : exported.columns()) {
+            columns.push_back({name, "g", exported.column(name).values().memptr(), ARROW_FLAG_NULLABLE});
+        }
+        arrow::export_struct(data, exported.size(), columns, array, schema);
+    }
+
+}  // polars
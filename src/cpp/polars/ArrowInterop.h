@@ -0,0 +1,143 @@
+#ifndef POLARS_ARROWINTEROP_H
+#define POLARS_ARROWINTEROP_H
+
+#include "DataFrame.h"
+#include "Series.h"
+#include "SeriesMask.h"
+#include "TimeSeries.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+
+// The structs of the Arrow C data interface (https://arrow.apache.org/docs/format/CDataInterface.html), guarded as the
+// specification requires so that they can be included alongside Arrow's own definition.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+
+/**
+ * Exchanging Series, TimeSeries and DataFrames with Arrow through its C data interface, without copying the columns.
+ *
+ * A Series is a struct array ("+s") of an "index" and a "value" child, and a DataFrame one of an "index" and a child
+ * per column, in order. Imports find the index by name, or take the first child, and take the other children as values.
+ *
+ * Importing takes ownership of the array and schema, leaving them released as the specification describes for a
+ * move. Float64 children that are 8 byte aligned are wrapped as Armadillo vectors over Arrow's buffers; the array is
+ * released once no Series or SeriesMask shares the resulting index, so those buffers must not be written to meanwhile.
+ * Other children - float32, 32 and 64 bit integers, and timestamps - are converted into new vectors. Nulls in the index
+ * are rejected. Nulls in values become NAN, which copies a column that has any, unless a SeriesMask of the valid
+ * values is asked for instead, in which case the values are wrapped as they are.
+ *
+ * Exporting moves the Series or DataFrame into the array's private data, so Arrow's buffers point at the index and
+ * values it already holds; pass it with std::move to avoid copying the values. The index of a TimeSeries is exported as
+ * an int64 timestamp, with a "UTC" time zone for system_clock, from its exact ticks - over them when the time point's
+ * period is an Arrow unit, otherwise as a converted copy. A label that isn't a finite tick count, or a timestamp that
+ * overflows the unit, is rejected with std::invalid_argument. NANs in the values are exported as values rather than
+ * nulls.
+ */
+namespace polars {
+
+    namespace arrow {
+
+        // Tick period of a time index, as in std::ratio; 0 / 1 for plain labels.
+        struct Period {
+            std::int64_t num;
+            std::int64_t den;
+        };
+
+        Series import_series(ArrowArray *array, ArrowSchema *schema, SeriesMask *valid, Period period);
+
+        void export_series(Series series, ArrowArray *array, ArrowSchema *schema, Period period,
+                           const std::string &timezone);
+
+        template<class TimePointType>
+        Period period_of() {
+            return {TimePointType::period::num, TimePointType::period::den};
+        }
+
+        template<class TimePointType>
+        std::string timezone_of() {
+            return std::is_same<typename TimePointType::clock, std::chrono::system_clock>::value ? "UTC" : "";
+        }
+
+    }  // arrow
+
+    /**
+     * Series over an imported struct array of an index and values. If valid is given, it is set to whether each value
+     * is non-null, and null values are left as they are rather than set to NAN.
+     */
+    Series import_arrow(ArrowArray *array, ArrowSchema *schema, SeriesMask *valid = nullptr);
+
+    /**
+     * DataFrame over an imported struct array, with a column named after each child other than the index.
+     */
+    DataFrame import_arrow_dataframe(ArrowArray *array, ArrowSchema *schema);
+
+    /**
+     * TimeSeries over an imported struct array whose index holds timestamps, which are converted to ticks of
+     * TimePointType's duration, rounding down, and kept exactly as int64s; timestamps in that unit already are used
+     * without copying. An int64 or float64 index is taken to hold those ticks already.
+     */
+    template<class TimePointType>
+    TimeSeries<TimePointType> import_arrow_timeseries(ArrowArray *array, ArrowSchema *schema,
+                                                      SeriesMask *valid = nullptr) {
+        return TimeSeries<TimePointType>::from_series(
+                arrow::import_series(array, schema, valid, arrow::period_of<TimePointType>()));
+    }
+
+    void export_arrow(Series series, ArrowArray *array, ArrowSchema *schema);
+
+    void export_arrow(DataFrame df, ArrowArray *array, ArrowSchema *schema);
+
+    template<class TimePointType>
+    void export_arrow(TimeSeries<TimePointType> ts, ArrowArray *array, ArrowSchema *schema) {
+        arrow::export_series(std::move(ts), array, schema, arrow::period_of<TimePointType>(),
+                             arrow::timezone_of<TimePointType>());
+    }
+
+}  // polars
+
+
+#endif //POLARS_ARROWINTEROP_H
@@ -0,0 +1,188 @@
+#include "BinaryFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace polars {
+
+    namespace binary {
+
+        namespace {
+
+            const char magic[8] = {'P', 'O', 'L', 'A', 'R', 'S', 'S', 'B'};
+            // Version 1 files have no index_dtype and always a float64 index.
+            const std::uint32_t version = 2;
+            const std::uint32_t byte_order = 0x01020304;
+            const std::uint32_t float64 = 1;
+            const std::uint32_t int64 = 2;
+            const std::uint32_t sorted_flag = 1;
+
+            const std::uint64_t header_size = 128;
+            const std::uint64_t block_alignment = 64;
+
+            struct Header {
+                char magic[8];
+                std::uint32_t version;
+                std::uint32_t byte_order;
+                std::uint32_t dtype;
+                std::uint32_t index_kind;
+                std::uint32_t flags;
+                std::uint32_t index_dtype;
+                std::uint64_t length;
+                std::int64_t period_num;
+                std::int64_t period_den;
+                std::uint64_t index_offset;
+                std::uint64_t values_offset;
+                char padding[header_size - 72];
+            };
+
+            static_assert(sizeof(Header) == header_size, "binary::Header must be exactly header_size bytes");
+
+            std::uint64_t aligned(std::uint64_t offset) {
+                return (offset + block_alignment - 1) / block_alignment * block_alignment;
+            }
+
+            // A read-only file mapping, unmapped once the last vector over it has gone.
+            struct Mapping {
+                void *address;
+                std::size_t size;
+
+                ~Mapping() {
+                    munmap(address, size);
+                }
+            };
+
+            std::shared_ptr<Mapping> map_file(const std::string &path) {
+                int fd = open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    throw std::runtime_error("map_binary: cannot open " + path);
+                }
+                struct stat info;
+                if (fstat(fd, &info) != 0) {
+                    close(fd);
+                    throw std::runtime_error("map_binary: cannot stat " + path);
+                }
+                std::size_t size = info.st_size;
+                if (size < header_size) {
+                    close(fd);
+                    throw std::runtime_error("map_binary: " + path + " is too short for a header");
+                }
+
+                // Private and writable, as Armadillo wants non-const memory; pages are only copied if written to.
+                void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                close(fd);
+                if (address == MAP_FAILED) {
+                    throw std::runtime_error("map_binary: cannot map " + path);
+                }
+                return std::shared_ptr<Mapping>(new Mapping{address, size});
+            }
+
+        }  // namespace
+
+
+        void write(const std::string &path, const Series &series, IndexKind kind, Period period) {
+            std::uint64_t n = series.size();
+            std::uint64_t block_size = n * sizeof(double);
+            // The exact ticks of a TimeSeries, rather than its labels, which are rounded beyond 2^53.
+            const SharedIndex &index = series.shared_index();
+            bool ticks = index.has_ticks();
+
+            Header header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.version = version;
+            header.byte_order = byte_order;
+            header.dtype = float64;
+            header.index_kind = static_cast<std::uint32_t>(kind);
+            header.flags = index.is_sorted() ? sorted_flag : 0;
+            header.index_dtype = ticks ? int64 : float64;
+            header.length = n;
+            header.period_num = period.num;
+            header.period_den = period.den;
+            header.index_offset = header_size;
+            header.values_offset = aligned(header.index_offset + block_size);
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("write_binary: cannot open " + path);
+            }
+
+            std::vector<char> padding(block_alignment, 0);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(ticks ? reinterpret_cast<const char *>(index.ticks())
+                             : reinterpret_cast<const char *>(index->memptr()), block_size);
+            file.write(padding.data(), header.values_offset - header.index_offset - block_size);
+            file.write(reinterpret_cast<const char *>(series.values().memptr()), block_size);
+
+            if (!file.flush()) {
+                throw std::runtime_error("write_binary: failed writing " + path);
+            }
+        }
+
+
+        Series map(const std::string &path, IndexKind kind, Period period) {
+            std::shared_ptr<Mapping> mapping = map_file(path);
+
+            const Header &header = *static_cast<const Header *>(mapping->address);
+            if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+                throw std::runtime_error("map_binary: " + path + " is not a polars binary file");
+            }
+            std::uint32_t index_dtype = header.version == 1 ? float64 : header.index_dtype;
+            if ((header.version != 1 && header.version != version) || header.byte_order != byte_order ||
+                header.dtype != float64 || (index_dtype != float64 && index_dtype != int64)) {
+                throw std::runtime_error("map_binary: " + path + " has an unsupported version, byte order or dtype");
+            }
+
+            std::uint64_t n = header.length;
+            std::uint64_t block_size = n * sizeof(double);
+            if (n > mapping->size / sizeof(double) ||
+                header.index_offset % block_alignment != 0 || header.values_offset % block_alignment != 0 ||
+                header.index_offset < header_size || header.index_offset + block_size > header.values_offset ||
+                header.values_offset > mapping->size || block_size > mapping->size - header.values_offset) {
+                throw std::runtime_error("map_binary: " + path + " is truncated or corrupt");
+            }
+
+            if (header.index_kind != static_cast<std::uint32_t>(kind) || header.period_num != period.num ||
+                header.period_den != period.den) {
+                throw std::invalid_argument("map_binary: " + path + " holds a different kind of index");
+            }
+
+            char *base = static_cast<char *>(mapping->address);
+            double *values = reinterpret_cast<double *>(base + header.values_offset);
+            bool sorted = (header.flags & sorted_flag) != 0;
+
+            // The index keeps the mapping alive, and every Series using the values also holds the index.
+            if (index_dtype == int64) {
+                std::shared_ptr<const std::int64_t> ticks(
+                        mapping, reinterpret_cast<const std::int64_t *>(base + header.index_offset));
+                return Series(arma::vec(values, n, false, false),
+                              SharedIndex::adopt_ticks(std::move(ticks), n, sorted));
+            }
+            double *index = reinterpret_cast<double *>(base + header.index_offset);
+            std::shared_ptr<const arma::vec> index_vec(new arma::vec(index, n, false, true),
+                                                       [mapping](const arma::vec *vec) { delete vec; });
+
+            return Series(arma::vec(values, n, false, false), SharedIndex::adopt(std::move(index_vec), sorted));
+        }
+
+    }  // binary
+
+
+    void write_binary(const std::string &path, const Series &series) {
+        binary::write(path, series, binary::IndexKind::labels, {0, 1});
+    }
+
+
+    Series map_binary(const std::string &path) {
+        return binary::map(path, binary::IndexKind::labels, {0, 1});
+    }
+
+}  // polars
@@ -0,0 +1,73 @@
+#ifndef POLARS_BINARYFILE_H
+#define POLARS_BINARYFILE_H
+
+#include "Series.h"
+#include "TimeSeries.h"
+
+#include <cstdint>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * Columnar binary files of a single Series, which are read back by memory-mapping them rather than parsing.
+ *
+ * A file is a 128 byte header followed by the index and then the values, each in native byte order in a block starting
+ * on a 64 byte boundary. Values are float64, and so is the index, except for a TimeSeries' time points, which are
+ * written as their exact int64 ticks. The header records the format version, byte order, dtypes, length, whether the
+ * index is sorted, and for a TimeSeries the tick period of its index, so that it can only be read back as the same time
+ * point type. Files of version 1, which always have a float64 index, can still be mapped.
+ *
+ * map_binary returns a Series whose index and values are Armadillo vectors over the mapped pages, so nothing is copied
+ * and pages are only read from disk when used. The mapping is private and stays open as long as any Series or
+ * SeriesMask sharing that index exists. Only POSIX systems (mmap) are supported.
+ */
+namespace polars {
+
+    namespace binary {
+
+        enum class IndexKind : std::uint32_t {
+            labels = 0,
+            time = 1
+        };
+
+        // Tick period of a time index, as in std::ratio; 0 / 1 for plain labels.
+        struct Period {
+            std::int64_t num;
+            std::int64_t den;
+        };
+
+        void write(const std::string &path, const Series &series, IndexKind kind, Period period);
+
+        Series map(const std::string &path, IndexKind kind, Period period);
+
+        template<class TimePointType>
+        Period period_of() {
+            return {TimePointType::period::num, TimePointType::period::den};
+        }
+
+    }  // binary
+
+    void write_binary(const std::string &path, const Series &series);
+
+    Series map_binary(const std::string &path);
+
+    template<class TimePointType>
+    void write_binary(const std::string &path, const TimeSeries<TimePointType> &ts) {
+        binary::write(path, ts, binary::IndexKind::time, binary::period_of<TimePointType>());
+    }
+
+    /**
+     * Maps a file written from a TimeSeries with the same tick period as TimePointType; anything else is rejected.
+     */
+    template<class TimePointType>
+    TimeSeries<TimePointType> map_binary_timeseries(const std::string &path) {
+        return TimeSeries<TimePointType>::from_series(
+                binary::map(path, binary::IndexKind::time, binary::period_of<TimePointType>()));
+    }
+
+}  // polars
+
+
+#endif //POLARS_BINARYFILE_H
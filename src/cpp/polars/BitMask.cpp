@@ -0,0 +1,146 @@
+#include "BitMask.h"
+
+#include <bitset>
+#include <stdexcept>
+
+
+namespace polars {
+
+    BitMask::BitMask(arma::uword size) : n(size), words((size + word_bits - 1) / word_bits, 0) {}
+
+
+    BitMask::BitMask(const arma::uvec &flags) : BitMask(flags.n_elem) {
+        const arma::uword *data = flags.memptr();
+        for (arma::uword i = 0; i < n; i++) {
+            words[i / word_bits] |= Word(data[i] != 0) << (i % word_bits);
+        }
+    }
+
+
+    BitMask::BitMask(const std::uint8_t *bitmap, arma::uword offset, arma::uword size) : BitMask(size) {
+        if (size == 0) {
+            return;
+        }
+        // Assemble each word from the bytes it overlaps, never reading past the last byte holding one of the bits.
+        arma::uword lastByte = (offset + size - 1) / 8;
+        auto byte = [bitmap, lastByte](arma::uword i) { return i <= lastByte ? Word(bitmap[i]) : Word(0); };
+        unsigned shift = offset % 8;
+
+        for (arma::uword w = 0; w < words.size(); w++) {
+            arma::uword first = (offset + w * word_bits) / 8;
+            Word word = 0;
+            for (unsigned k = 0; k < 8; k++) {
+                word |= byte(first + k) << (8 * k);
+            }
+            if (shift != 0) {
+                word = (word >> shift) | (byte(first + 8) << (word_bits - shift));
+            }
+            words[w] = word;
+        }
+        clear_tail();
+    }
+
+
+    arma::uword BitMask::count() const {
+        arma::uword total = 0;
+        for (Word word : words) {
+            total += std::bitset<word_bits>(word).count();
+        }
+        return total;
+    }
+
+
+    arma::uvec BitMask::find() const {
+        arma::uvec positions(count());
+        arma::uword *out = positions.memptr();
+        for_each_set([&out](arma::uword i) { *out++ = i; });
+        return positions;
+    }
+
+
+    arma::uvec BitMask::to_uvec() const {
+        arma::uvec flags(n);
+        arma::uword *out = flags.memptr();
+        for (arma::uword i = 0; i < n; i++) {
+            out[i] = (*this)[i];
+        }
+        return flags;
+    }
+
+
+    BitMask BitMask::elem(const arma::uvec &positions) const {
+        BitMask result(positions.n_elem);
+        for (arma::uword i = 0; i < positions.n_elem; i++) {
+            if ((*this)[positions[i]]) {
+                result.set(i);
+            }
+        }
+        return result;
+    }
+
+
+    BitMask BitMask::operator&(const BitMask &rhs) const {
+        check_size(rhs);
+        BitMask result(*this);
+        for (arma::uword w = 0; w < words.size(); w++) {
+            result.words[w] &= rhs.words[w];
+        }
+        return result;
+    }
+
+
+    BitMask BitMask::operator|(const BitMask &rhs) const {
+        check_size(rhs);
+        BitMask result(*this);
+        for (arma::uword w = 0; w < words.size(); w++) {
+            result.words[w] |= rhs.words[w];
+        }
+        return result;
+    }
+
+
+    BitMask BitMask::operator^(const BitMask &rhs) const {
+        check_size(rhs);
+        BitMask result(*this);
+        for (arma::uword w = 0; w < words.size(); w++) {
+            result.words[w] ^= rhs.words[w];
+        }
+        return result;
+    }
+
+
+    BitMask BitMask::operator~() const {
+        BitMask result(*this);
+        for (Word &word : result.words) {
+            word = ~word;
+        }
+        result.clear_tail();
+        return result;
+    }
+
+
+    bool BitMask::operator==(const BitMask &rhs) const {
+        return n == rhs.n && words == rhs.words;
+    }
+
+
+    bool BitMask::operator!=(const BitMask &rhs) const {
+        return !(*this == rhs);
+    }
+
+
+    void BitMask::check_size(const BitMask &rhs) const {
+        if (n != rhs.n) {
+            throw std::logic_error("BitMask: incompatible sizes");
+        }
+    }
+
+
+    void BitMask::clear_tail() {
+        arma::uword used = n % word_bits;
+        if (used != 0) {
+            words.back() &= (Word(1) << used) - 1;
+        }
+    }
+
+}  // polars
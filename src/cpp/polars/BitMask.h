@@ -0,0 +1,117 @@
+#ifndef POLARS_BITMASK_H
+#define POLARS_BITMASK_H
+
+#include "armadillo"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace polars {
+
+    /**
+     * Fixed-size sequence of flags packed 64 to a word, used as the storage of SeriesMask.
+     *
+     * This takes 1 bit per flag rather than the 64 of an arma::uvec, and lets boolean logic and counting work a whole word
+     * at a time. Bits past size() in the last word are always kept clear, so whole words can be compared and counted.
+     */
+    class BitMask {
+    public:
+        typedef std::uint64_t Word;
+
+        BitMask() = default;
+
+        explicit BitMask(arma::uword size);
+
+        /**
+         * Set for every non-zero element of flags.
+         */
+        explicit BitMask(const arma::uvec &flags);
+
+        /**
+         * Copy of size bits of a bitmap, starting at bit offset, numbered from the least significant bit of each byte
+         * as in Arrow validity bitmaps.
+         */
+        BitMask(const std::uint8_t *bitmap, arma::uword offset, arma::uword size);
+
+        inline arma::uword size() const {
+            return n;
+        }
+
+        inline bool operator[](arma::uword i) const {
+            return (words[i / word_bits] >> (i % word_bits)) & 1u;
+        }
+
+        inline void set(arma::uword i) {
+            words[i / word_bits] |= Word(1) << (i % word_bits);
+        }
+
+        /**
+         * Number of set flags, by popcount of each word.
+         */
+        arma::uword count() const;
+
+        /**
+         * Positions of the set flags, in order.
+         */
+        arma::uvec find() const;
+
+        /**
+         * Calls f(position) for each set flag in order, skipping over clear words without testing each bit.
+         */
+        template<class F>
+        void for_each_set(F f) const {
+            for (arma::uword w = 0; w < words.size(); w++) {
+                Word word = words[w];
+                while (word) {
+                    f(w * word_bits + lowest_set_bit(word));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        arma::uvec to_uvec() const;
+
+        BitMask elem(const arma::uvec &positions) const;
+
+        BitMask operator&(const BitMask &rhs) const;
+
+        BitMask operator|(const BitMask &rhs) const;
+
+        BitMask operator^(const BitMask &rhs) const;
+
+        BitMask operator~() const;
+
+        bool operator==(const BitMask &rhs) const;
+
+        bool operator!=(const BitMask &rhs) const;
+
+        static const arma::uword word_bits = 64;
+
+    private:
+        static inline arma::uword lowest_set_bit(Word word) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(word);
+#else
+            arma::uword bit = 0;
+            while (!(word & 1u)) {
+                word >>= 1;
+                bit++;
+            }
+            return bit;
+#endif
+        }
+
+        void check_size(const BitMask &rhs) const;
+
+        // Clears the bits past size() in the last word.
+        void clear_tail();
+
+        arma::uword n = 0;
+        std::vector<Word> words;
+    };
+
+}  // polars
+
+
+#endif //POLARS_BITMASK_H
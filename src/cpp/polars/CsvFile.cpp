@@ -0,0 +1,766 @@
+#include "CsvFile.h"
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace polars {
+
+    namespace csv {
+
+        namespace {
+
+            // Bytes read from the file at a time, and the smallest piece of that worth handing to another thread.
+            const std::size_t chunk_size = std::size_t(1) << 24;
+            const std::size_t min_piece_size = std::size_t(1) << 16;
+
+            // Bytes of output buffered before writing them out.
+            const std::size_t write_buffer_size = std::size_t(1) << 20;
+
+            const std::int64_t nanos_per_second = 1000000000;
+
+            // Powers of ten that are exact as doubles.
+            const double exact_powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+            inline bool is_digit(char c) {
+                return c >= '0' && c <= '9';
+            }
+
+            inline bool is_space(char c) {
+                return c == ' ' || c == '\t';
+            }
+
+            void trim(const char *&first, const char *&last) {
+                while (first != last && is_space(*first)) ++first;
+                while (last != first && is_space(last[-1])) --last;
+            }
+
+            bool equals_lower(const char *first, const char *last, const char *word) {
+                for (; first != last; ++first, ++word) {
+                    if (*word == '\0' || (*first | 0x20) != *word) return false;
+                }
+                return *word == '\0';
+            }
+
+            std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+                std::int64_t q = a / b;
+                return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+            }
+
+            // Days since 1970-01-01 of a date in the proleptic Gregorian calendar, and back (H. Hinnant's algorithms).
+            std::int64_t days_from_civil(std::int64_t y, unsigned m, unsigned d) {
+                y -= m <= 2;
+                std::int64_t era = floor_div(y, 400);
+                unsigned yoe = static_cast<unsigned>(y - era * 400);
+                unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+                unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+                return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+            }
+
+            void civil_from_days(std::int64_t z, std::int64_t &y, unsigned &m, unsigned &d) {
+                z += 719468;
+                std::int64_t era = floor_div(z, 146097);
+                unsigned doe = static_cast<unsigned>(z - era * 146097);
+                unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+                unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+                unsigned mp = (5 * doy + 2) / 153;
+                d = doy - (153 * mp + 2) / 5 + 1;
+                m = mp < 10 ? mp + 3 : mp - 9;
+                y = static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2);
+            }
+
+            // Nearest double to mantissa * 10^exponent for exponents from -21 to 19, using 128 bit integers where the
+            // compiler has them, or false otherwise. Multiplying is exact in 128 bits, and converting that rounds
+            // correctly. Dividing starts from the nearly right quotient in doubles and steps to a neighbour while the
+            // exact quotient lies beyond the midpoint on either side; scaled by 10^-exponent * 2^(55 - e), where
+            // 2^(e - 1) <= quotient < 2^e, the quotient and midpoints are all integers below 2^125.
+            bool scale_exactly(std::uint64_t mantissa, int exponent, double &result) {
+#ifdef __SIZEOF_INT128__
+                typedef unsigned __int128 uint128;
+                if (exponent < -21 || exponent > 19) {
+                    return false;
+                }
+                uint128 power = 1;
+                for (int i = 0; i < std::abs(exponent); i++) {
+                    power *= 10;
+                }
+                if (exponent >= 0) {
+                    result = static_cast<double>(mantissa * power);
+                    return true;
+                }
+
+                // The guess is positive and normal, so stepping to a neighbour is adding one to its bits.
+                double guess = static_cast<double>(mantissa) / exact_powers_of_ten[-exponent];
+                std::uint64_t bits;
+                std::memcpy(&bits, &guess, sizeof(bits));
+                for (int step = 0; step < 4; step++) {
+                    int e = static_cast<int>(bits >> 52) - 1022;
+                    std::uint64_t m = (bits & ((std::uint64_t(1) << 52) - 1)) | (std::uint64_t(1) << 52);
+                    if (e > 55) {
+                        return false;
+                    }
+                    uint128 quotient = static_cast<uint128>(mantissa) << (55 - e);
+                    // Midpoints with the neighbours above and below; the one below is closer at a power of two.
+                    uint128 above = static_cast<uint128>(4 * m + 2) * power;
+                    uint128 below = (m == std::uint64_t(1) << 52 ? 4 * m - 1 : 4 * m - 2) * power;
+
+                    // Ties go to the even mantissa.
+                    if (quotient > above || (quotient == above && (m & 1))) {
+                        bits++;
+                    } else if (quotient < below || (quotient == below && (m & 1))) {
+                        bits--;
+                    } else {
+                        std::memcpy(&result, &bits, sizeof(bits));
+                        return true;
+                    }
+                }
+#endif
+                return false;
+            }
+
+            // Parses [first, last) without throwing, so that a failed parse can fall back to another format cheaply.
+            bool try_parse_double(const char *first, const char *last, double &result) {
+                trim(first, last);
+                if (first == last) {
+                    result = NAN;
+                    return true;
+                }
+
+                const char *p = first;
+                bool negative = *p == '-';
+                if (*p == '-' || *p == '+') ++p;
+
+                if (p != last && !is_digit(*p) && *p != '.') {
+                    if (equals_lower(p, last, "nan")) {
+                        result = NAN;
+                    } else if (equals_lower(p, last, "inf") || equals_lower(p, last, "infinity")) {
+                        result = negative ? -INFINITY : INFINITY;
+                    } else {
+                        return false;
+                    }
+                    return true;
+                }
+
+                // Up to 19 significant digits fit in the mantissa; any beyond that send us to strtod.
+                std::uint64_t mantissa = 0;
+                int digits = 0;
+                int exponent = 0;
+                bool anyDigits = false;
+                bool truncated = false;
+
+                for (; p != last && is_digit(*p); ++p) {
+                    anyDigits = true;
+                    if (digits < 19) {
+                        mantissa = mantissa * 10 + (*p - '0');
+                        digits += mantissa != 0;
+                    } else {
+                        exponent++;
+                        truncated |= *p != '0';
+                    }
+                }
+                if (p != last && *p == '.') {
+                    for (++p; p != last && is_digit(*p); ++p) {
+                        anyDigits = true;
+                        if (digits < 19) {
+                            mantissa = mantissa * 10 + (*p - '0');
+                            digits += mantissa != 0;
+                            exponent--;
+                        } else {
+                            truncated |= *p != '0';
+                        }
+                    }
+                }
+                if (!anyDigits) {
+                    return false;
+                }
+                if (p != last && (*p == 'e' || *p == 'E')) {
+                    ++p;
+                    bool negativeExponent = p != last && *p == '-';
+                    if (p != last && (*p == '-' || *p == '+')) ++p;
+                    if (p == last || !is_digit(*p)) {
+                        return false;
+                    }
+                    int explicitExponent = 0;
+                    for (; p != last && is_digit(*p); ++p) {
+                        explicitExponent = std::min(explicitExponent * 10 + (*p - '0'), 100000);
+                    }
+                    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                }
+                if (p != last) {
+                    return false;
+                }
+
+                // Both the mantissa and the power of ten are exact, so a single multiply or divide rounds correctly.
+                if (!truncated && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+                    double value = static_cast<double>(mantissa);
+                    value = exponent < 0 ? value / exact_powers_of_ten[-exponent]
+                                         : value * exact_powers_of_ten[exponent];
+                    result = negative ? -value : value;
+                    return true;
+                }
+
+                // Full precision doubles, e.g. printed with %.17g, have more digits than that.
+                double value;
+                if (!truncated && scale_exactly(mantissa, exponent, value)) {
+                    result = negative ? -value : value;
+                    return true;
+                }
+
+                char text[64];
+                if (last - first < static_cast<std::ptrdiff_t>(sizeof(text))) {
+                    std::memcpy(text, first, last - first);
+                    text[last - first] = '\0';
+                    result = std::strtod(text, nullptr);
+                } else {
+                    result = std::strtod(std::string(first, last).c_str(), nullptr);
+                }
+                return true;
+            }
+
+            // Reads exactly n digits.
+            bool parse_digits(const char *&p, const char *last, int n, int &value) {
+                if (last - p < n) return false;
+                value = 0;
+                for (int i = 0; i < n; i++, p++) {
+                    if (!is_digit(*p)) return false;
+                    value = value * 10 + (*p - '0');
+                }
+                return true;
+            }
+
+            // A point in time as whole seconds since the epoch and the nanoseconds after that.
+            struct Instant {
+                std::int64_t seconds;
+                std::int64_t nanos;
+            };
+
+            bool try_parse_iso8601(const char *first, const char *last, Instant &instant) {
+                const char *p = first;
+                int year, month, day, hour = 0, minute = 0, second = 0;
+                std::int64_t nanos = 0;
+                std::int64_t offset = 0;
+
+                if (!parse_digits(p, last, 4, year) || p == last || *p++ != '-' || !parse_digits(p, last, 2, month) ||
+                    p == last || *p++ != '-' || !parse_digits(p, last, 2, day)) {
+                    return false;
+                }
+                if (p != last) {
+                    if (*p != 'T' && *p != ' ') return false;
+                    ++p;
+                    if (!parse_digits(p, last, 2, hour) || p == last || *p++ != ':' ||
+                        !parse_digits(p, last, 2, minute)) {
+                        return false;
+                    }
+                    if (p != last && *p == ':') {
+                        ++p;
+                        if (!parse_digits(p, last, 2, second)) return false;
+                        if (p != last && (*p == '.' || *p == ',')) {
+                            ++p;
+                            if (p == last || !is_digit(*p)) return false;
+                            std::int64_t scale = nanos_per_second;
+                            for (; p != last && is_digit(*p); ++p) {
+                                scale /= 10;
+                                nanos += (*p - '0') * scale;
+                            }
+                        }
+                    }
+                    if (p != last && *p == 'Z') {
+                        ++p;
+                    } else if (p != last && (*p == '+' || *p == '-')) {
+                        int sign = *p++ == '-' ? -1 : 1;
+                        int offsetHours, offsetMinutes = 0;
+                        if (!parse_digits(p, last, 2, offsetHours)) return false;
+                        if (p != last && *p == ':') ++p;
+                        if (p != last && !parse_digits(p, last, 2, offsetMinutes)) return false;
+                        offset = sign * (offsetHours * 3600 + offsetMinutes * 60);
+                    }
+                    if (p != last) return false;
+                }
+                if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+                    return false;
+                }
+
+                instant.seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+                instant.seconds -= offset;
+                instant.nanos = nanos;
+                return true;
+            }
+
+            bool try_parse_epoch(const char *first, const char *last, CsvOptions::EpochUnit unit, Instant &instant) {
+                std::int64_t unitsPerSecond = 1;
+                switch (unit) {
+                    case CsvOptions::EpochUnit::seconds: unitsPerSecond = 1; break;
+                    case CsvOptions::EpochUnit::milliseconds: unitsPerSecond = 1000; break;
+                    case CsvOptions::EpochUnit::microseconds: unitsPerSecond = 1000000; break;
+                    case CsvOptions::EpochUnit::nanoseconds: unitsPerSecond = nanos_per_second; break;
+                }
+                std::int64_t nanosPerUnit = nanos_per_second / unitsPerSecond;
+
+                // Integers that fit in an int64, possibly with a fraction, are taken exactly; anything else, e.g.
+                // 1.5e9, as a double.
+                const char *p = first;
+                bool negative = p != last && *p == '-';
+                if (p != last && (*p == '-' || *p == '+')) ++p;
+                std::int64_t units = 0;
+                std::int64_t fractionNanos = 0;
+                int digits = 0;
+                bool overflow = false;
+                for (; p != last && is_digit(*p); ++p, ++digits) {
+                    overflow = overflow || __builtin_mul_overflow(units, 10, &units) ||
+                               __builtin_add_overflow(units, *p - '0', &units);
+                }
+                if (p != last && *p == '.') {
+                    std::int64_t scale = nanosPerUnit;
+                    for (++p; p != last && is_digit(*p); ++p) {
+                        scale /= 10;
+                        fractionNanos += (*p - '0') * scale;
+                    }
+                }
+
+                if (p == last && digits > 0 && !overflow) {
+                    std::int64_t seconds = units / unitsPerSecond;
+                    std::int64_t nanos = (units % unitsPerSecond) * nanosPerUnit + fractionNanos;
+                    if (negative) {
+                        seconds = -seconds - (nanos != 0);
+                        nanos = nanos != 0 ? nanos_per_second - nanos : 0;
+                    }
+                    instant = {seconds, nanos};
+                    return true;
+                }
+
+                double value;
+                if (!try_parse_double(first, last, value) || !std::isfinite(value)) {
+                    return false;
+                }
+                double seconds = std::floor(value / unitsPerSecond);
+                if (!(seconds >= -9223372036854775808.0 && seconds < 9223372036854775808.0)) {
+                    return false;
+                }
+                instant = {static_cast<std::int64_t>(seconds),
+                           static_cast<std::int64_t>((value - seconds * unitsPerSecond) * nanosPerUnit)};
+                return true;
+            }
+
+            /**
+             * Ticks of period since the epoch, rounded down, using integer arithmetic for the usual periods. False if
+             * the count doesn't fit in an int64, e.g. nanoseconds beyond the year 2262.
+             */
+            bool try_to_ticks(const Instant &instant, Period period, std::int64_t &ticks) {
+                if (period.num == 1 && period.den <= nanos_per_second && nanos_per_second % period.den == 0) {
+                    return !__builtin_mul_overflow(instant.seconds, period.den, &ticks) &&
+                           !__builtin_add_overflow(ticks, instant.nanos / (nanos_per_second / period.den), &ticks);
+                }
+                if (period.den == 1) {
+                    ticks = floor_div(instant.seconds, period.num);
+                    return true;
+                }
+                long double seconds = instant.seconds + instant.nanos / static_cast<long double>(nanos_per_second);
+                long double count = std::floor(seconds * period.den / period.num);
+                if (!(count >= -9223372036854775808.0L && count < 9223372036854775808.0L)) {
+                    return false;
+                }
+                ticks = static_cast<std::int64_t>(count);
+                return true;
+            }
+
+            // Whether ticks round to an int64 count, which rules out NAN, infinities and values beyond its range.
+            bool is_representable_ticks(double ticks) {
+                return std::isfinite(ticks) && ticks >= -9223372036854775808.0 && ticks < 9223372036854775808.0;
+            }
+
+            Instant from_ticks(std::int64_t count, Period period) {
+                if (period.num == 1 && period.den <= nanos_per_second && nanos_per_second % period.den == 0) {
+                    std::int64_t seconds = floor_div(count, period.den);
+                    return {seconds, (count - seconds * period.den) * (nanos_per_second / period.den)};
+                }
+                if (period.den == 1) {
+                    return {count * period.num, 0};
+                }
+                long double exact = static_cast<long double>(count) * period.num / period.den;
+                auto seconds = static_cast<std::int64_t>(std::floor(exact));
+                return {seconds, static_cast<std::int64_t>((exact - seconds) * nanos_per_second)};
+            }
+
+            // A range of whole lines and the rows parsed from it.
+            struct Piece {
+                const char *first;
+                const char *last;
+                std::vector<double> index;
+                std::vector<std::int64_t> ticks;
+                std::vector<double> values;
+
+                // Start of the line that could not be parsed, if any, and why.
+                const char *errorLine = nullptr;
+                std::string error;
+            };
+
+            void parse_piece(Piece &piece, const CsvOptions &options, Period period) {
+                arma::uword lastColumn = std::max(options.indexColumn, options.valueColumn);
+                const char *line = piece.first;
+
+                while (line != piece.last) {
+                    auto newline = static_cast<const char *>(std::memchr(line, '\n', piece.last - line));
+                    const char *end = newline ? newline : piece.last;
+                    const char *next = newline ? newline + 1 : piece.last;
+                    if (end != line && end[-1] == '\r') --end;
+
+                    const char *start = line;
+                    trim(start, end);
+                    if (start == end) {
+                        line = next;
+                        continue;
+                    }
+
+                    try {
+                        const char *indexFirst = nullptr, *indexLast = nullptr;
+                        const char *valueFirst = nullptr, *valueLast = nullptr;
+                        const char *field = line;
+                        for (arma::uword column = 0; column <= lastColumn; column++) {
+                            if (field == nullptr) {
+                                throw std::invalid_argument("expected at least " + std::to_string(lastColumn + 1) +
+                                                            " columns");
+                            }
+                            auto delimiter = static_cast<const char *>(
+                                    std::memchr(field, options.delimiter, end - field));
+                            const char *fieldEnd = delimiter ? delimiter : end;
+                            if (column == options.indexColumn) {
+                                indexFirst = field;
+                                indexLast = fieldEnd;
+                            }
+                            if (column == options.valueColumn) {
+                                valueFirst = field;
+                                valueLast = fieldEnd;
+                            }
+                            field = delimiter ? delimiter + 1 : nullptr;
+                        }
+
+                        if (period.num != 0) {
+                            piece.ticks.push_back(parse_timestamp(indexFirst, indexLast, options.epochUnit, period));
+                        } else {
+                            piece.index.push_back(parse_double(indexFirst, indexLast));
+                        }
+                        piece.values.push_back(parse_double(valueFirst, valueLast));
+                    } catch (const std::invalid_argument &e) {
+                        piece.errorLine = line;
+                        piece.error = e.what();
+                        return;
+                    }
+
+                    line = next;
+                }
+            }
+
+            // Buffered output, so that the file is written in large blocks rather than a few bytes at a time.
+            class Writer {
+            public:
+                explicit Writer(const std::string &path) : file(path, std::ios::binary | std::ios::trunc), path(path) {
+                    if (!file) {
+                        throw std::runtime_error("write_csv: cannot open " + path);
+                    }
+                    buffer.reserve(write_buffer_size + 64);
+                }
+
+                void put(char c) {
+                    buffer.push_back(c);
+                }
+
+                void put(const char *s, std::size_t n) {
+                    buffer.append(s, n);
+                }
+
+                void put_integer(std::int64_t value, int minDigits = 1) {
+                    char digits[24];
+                    int n = 0;
+                    // Work in negatives, which also covers the most negative integer.
+                    std::int64_t rest = value < 0 ? value : -value;
+                    do {
+                        digits[n++] = static_cast<char>('0' - rest % 10);
+                        rest /= 10;
+                    } while (rest != 0 || n < minDigits);
+                    if (value < 0) put('-');
+                    while (n > 0) put(digits[--n]);
+                }
+
+                // Shortest of %.15g and %.17g that reads back as the same value; NAN is written as an empty field.
+                void put_double(double value) {
+                    if (std::isnan(value)) {
+                        return;
+                    }
+                    if (std::isinf(value)) {
+                        put(value < 0 ? "-inf" : "inf", value < 0 ? 4 : 3);
+                        return;
+                    }
+                    if (value == std::trunc(value) && std::abs(value) < 1e15) {
+                        put_integer(static_cast<std::int64_t>(value));
+                        return;
+                    }
+                    char text[32];
+                    int n = std::snprintf(text, sizeof(text), "%.15g", value);
+                    double roundTrip;
+                    if (!try_parse_double(text, text + n, roundTrip) || roundTrip != value) {
+                        n = std::snprintf(text, sizeof(text), "%.17g", value);
+                    }
+                    put(text, n);
+                }
+
+                void put_iso8601(const Instant &instant, Period period) {
+                    std::int64_t days = floor_div(instant.seconds, 86400);
+                    std::int64_t secondOfDay = instant.seconds - days * 86400;
+                    std::int64_t year;
+                    unsigned month, day;
+                    civil_from_days(days, year, month, day);
+
+                    put_integer(year, 4);
+                    put('-');
+                    put_integer(month, 2);
+                    put('-');
+                    put_integer(day, 2);
+                    if (period.den == 1 && period.num % 86400 == 0) {
+                        return;
+                    }
+                    put('T');
+                    put_integer(secondOfDay / 3600, 2);
+                    put(':');
+                    put_integer(secondOfDay / 60 % 60, 2);
+                    put(':');
+                    put_integer(secondOfDay % 60, 2);
+
+                    // As many decimals as the period needs: none for seconds, 3 for milliseconds, ...
+                    int decimals = period.den == 1 ? 0 : period.den <= 1000 ? 3 : period.den <= 1000000 ? 6 : 9;
+                    if (decimals > 0) {
+                        put('.');
+                        std::int64_t fraction = instant.nanos;
+                        for (int i = decimals; i < 9; i++) fraction /= 10;
+                        put_integer(fraction, decimals);
+                    }
+                }
+
+                void end_line() {
+                    buffer.push_back('\n');
+                    if (buffer.size() >= write_buffer_size) {
+                        flush();
+                    }
+                }
+
+                void flush() {
+                    file.write(buffer.data(), buffer.size());
+                    buffer.clear();
+                    if (!file) {
+                        throw std::runtime_error("write_csv: failed writing " + path);
+                    }
+                }
+
+            private:
+                std::ofstream file;
+                std::string path;
+                std::string buffer;
+            };
+
+        }  // namespace
+
+
+        double parse_double(const char *first, const char *last) {
+            double result;
+            if (!try_parse_double(first, last, result)) {
+                throw std::invalid_argument("'" + std::string(first, last) + "' is not a number");
+            }
+            return result;
+        }
+
+
+        std::int64_t parse_timestamp(const char *first, const char *last, CsvOptions::EpochUnit unit,
+                                     Period period) {
+            trim(first, last);
+            Instant instant{};
+            // Epoch numbers never have a '-' after 4 digits, so the first few characters tell which format this is.
+            bool iso8601 = last - first >= 10 && first[4] == '-';
+            if (iso8601 ? !try_parse_iso8601(first, last, instant) : !try_parse_epoch(first, last, unit, instant)) {
+                throw std::invalid_argument("'" + std::string(first, last) + "' is not a timestamp");
+            }
+            std::int64_t ticks;
+            if (!try_to_ticks(instant, period, ticks)) {
+                throw std::invalid_argument("'" + std::string(first, last) + "' is out of range for the time points");
+            }
+            return ticks;
+        }
+
+
+        Series read(const std::string &path, const CsvOptions &options, Period period) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("read_csv: cannot open " + path);
+            }
+            if (options.delimiter == '\n' || options.delimiter == '\r') {
+                throw std::invalid_argument("read_csv: the delimiter cannot be a line end");
+            }
+
+            std::vector<char> buffer(chunk_size);
+            std::size_t carried = 0;
+            std::size_t linesBefore = 0;
+            bool skipHeader = options.header;
+            bool done = false;
+
+            std::vector<std::vector<double>> indexParts;
+            std::vector<std::vector<std::int64_t>> tickParts;
+            std::vector<std::vector<double>> valueParts;
+            arma::uword rows = 0;
+
+            while (!done) {
+                file.read(buffer.data() + carried, buffer.size() - carried);
+                std::size_t filled = carried + static_cast<std::size_t>(file.gcount());
+                done = filled < buffer.size();
+
+                // Only parse up to the last line end, carrying a partial line over to the next chunk.
+                const char *first = buffer.data();
+                const char *last = first + filled;
+                if (!done) {
+                    while (last != first && last[-1] != '\n') --last;
+                    if (last == first) {
+                        // A single line longer than the buffer.
+                        carried = filled;
+                        buffer.resize(buffer.size() * 2);
+                        continue;
+                    }
+                }
+
+                if (skipHeader) {
+                    auto newline = static_cast<const char *>(std::memchr(first, '\n', last - first));
+                    first = newline ? newline + 1 : last;
+                    linesBefore += newline != nullptr;
+                    skipHeader = false;
+                }
+
+                // Split at line ends into pieces for the pool, or a single piece without one.
+                std::size_t pieceCount = options.pool ? options.pool->size() * 4 : 1;
+                pieceCount = std::max<std::size_t>(1, std::min(pieceCount, (last - first) / min_piece_size));
+                std::vector<Piece> pieces;
+                const char *pieceFirst = first;
+                for (std::size_t i = 1; i <= pieceCount && pieceFirst != last; i++) {
+                    const char *target = first + (last - first) * i / pieceCount;
+                    const char *pieceLast = i == pieceCount ? last : std::max(pieceFirst, target);
+                    while (pieceLast != last && pieceLast != pieceFirst && pieceLast[-1] != '\n') ++pieceLast;
+                    if (pieceLast == pieceFirst) continue;
+                    Piece piece;
+                    piece.first = pieceFirst;
+                    piece.last = pieceLast;
+                    pieces.push_back(std::move(piece));
+                    pieceFirst = pieceLast;
+                }
+
+                if (options.pool && pieces.size() > 1) {
+                    options.pool->parallel_for(pieces.size(), [&](arma::uword i) {
+                        parse_piece(pieces[i], options, period);
+                    });
+                } else {
+                    for (Piece &piece : pieces) {
+                        parse_piece(piece, options, period);
+                    }
+                }
+
+                for (Piece &piece : pieces) {
+                    if (piece.errorLine) {
+                        std::size_t line = linesBefore + std::count(first, piece.errorLine, '\n') + 1;
+                        throw std::invalid_argument("read_csv: line " + std::to_string(line) + " of " + path + ": " +
+                                                    piece.error);
+                    }
+                    rows += piece.values.size();
+                    indexParts.push_back(std::move(piece.index));
+                    tickParts.push_back(std::move(piece.ticks));
+                    valueParts.push_back(std::move(piece.values));
+                }
+                linesBefore += std::count(first, last, '\n');
+
+                carried = buffer.data() + filled - last;
+                std::memmove(buffer.data(), last, carried);
+            }
+
+            arma::vec values(rows);
+            arma::uword row = 0;
+            for (std::size_t i = 0; i < valueParts.size(); i++) {
+                std::copy(valueParts[i].begin(), valueParts[i].end(), values.begin() + row);
+                row += valueParts[i].size();
+            }
+
+            // Timestamps are kept as exact ticks, which doubles only hold up to 2^53.
+            if (period.num != 0) {
+                std::vector<std::int64_t> ticks;
+                ticks.reserve(rows);
+                for (std::vector<std::int64_t> &part : tickParts) {
+                    ticks.insert(ticks.end(), part.begin(), part.end());
+                }
+                return Series(std::move(values), SharedIndex::from_ticks(std::move(ticks)));
+            }
+            arma::vec index(rows);
+            row = 0;
+            for (std::vector<double> &part : indexParts) {
+                std::copy(part.begin(), part.end(), index.begin() + row);
+                row += part.size();
+            }
+            return Series(std::move(values), SharedIndex(std::move(index)));
+        }
+
+
+        void write(const std::string &path, const Series &series, const CsvOptions &options, Period period) {
+            const arma::vec &index = series.index();
+            const arma::vec &values = series.values();
+            // The exact ticks of a TimeSeries, rather than its labels, which are rounded beyond 2^53.
+            const SharedIndex &shared = series.shared_index();
+            const std::int64_t *ticks = shared.has_ticks() ? shared.ticks() : nullptr;
+            if (period.num != 0 && !ticks) {
+                // Checked before opening the file, so that a bad timestamp doesn't leave it half written.
+                for (arma::uword i = 0; i < index.n_elem; i++) {
+                    if (!is_representable_ticks(index[i])) {
+                        throw std::invalid_argument("write_csv: timestamp at row " + std::to_string(i) +
+                                                    " is not a finite tick count");
+                    }
+                }
+            }
+
+            Writer writer(path);
+            if (options.header) {
+                writer.put(period.num != 0 ? "timestamp" : "index", period.num != 0 ? 9 : 5);
+                writer.put(options.delimiter);
+                writer.put("value", 5);
+                writer.end_line();
+            }
+
+            for (arma::uword i = 0; i < series.size(); i++) {
+                if (period.num == 0) {
+                    writer.put_double(index[i]);
+                } else {
+                    std::int64_t count = ticks ? ticks[i] : std::llround(index[i]);
+                    if (options.writeIso8601) {
+                        writer.put_iso8601(from_ticks(count, period), period);
+                    } else {
+                        writer.put_integer(count);
+                    }
+                }
+                writer.put(options.delimiter);
+                writer.put_double(values[i]);
+                writer.end_line();
+            }
+            writer.flush();
+        }
+
+    }  // csv
+
+
+    Series read_csv(const std::string &path, const CsvOptions &options) {
+        return csv::read(path, options, {0, 1});
+    }
+
+
+    void write_csv(const std::string &path, const Series &series, const CsvOptions &options) {
+        csv::write(path, series, options, {0, 1});
+    }
+
+}  // polars
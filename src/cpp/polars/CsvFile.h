@@ -0,0 +1,113 @@
+#ifndef POLARS_CSVFILE_H
+#define POLARS_CSVFILE_H
+
+#include "Series.h"
+#include "TimeSeries.h"
+
+#include "armadillo"
+
+#include <cstdint>
+#include <string>
+
+
+/**
+ * Reading and writing a Series as two columns of a delimited text file, without going through std::map.
+ *
+ * The reader works through the file in large chunks, splitting each at line ends so that, given a ThreadPool, the
+ * pieces are parsed in parallel. Numbers are parsed by hand - exactly, on the fast path, when the digits fit in 53 bits
+ * and the power of ten is at most 22, and by strtod otherwise - and the columns are built as Armadillo vectors. Rows
+ * are kept in file order, so an index that is not sorted or has duplicates is kept as is, unlike Series::from_map.
+ *
+ * Fields are separated by a single delimiter character and may not be quoted. Empty fields, and nan/inf in any case,
+ * read as NAN and +-inf. Lines may end in \n or \r\n, and blank lines are skipped.
+ *
+ * Timestamps read into a TimeSeries are either ISO 8601 - YYYY-MM-DD, optionally followed by T or a space,
+ * hh:mm[:ss[.f]] and Z or an offset (+hh:mm, +hhmm or +hh) - or numbers counting epochUnit since 1970-01-01 UTC. Either
+ * is converted to ticks of the TimeSeries' time point duration, rounding down, and kept exactly as int64s. Epoch
+ * integers are read exactly up to the int64 limit of 19 digits, and timestamps whose ticks overflow an int64 are
+ * rejected. An offset is subtracted to give UTC, and a time without one is taken as is, which suits both system_clock
+ * and local_time series.
+ */
+namespace polars {
+    class ThreadPool;
+
+    struct CsvOptions {
+        enum class EpochUnit {
+            seconds,
+            milliseconds,
+            microseconds,
+            nanoseconds
+        };
+
+        char delimiter = ',';
+
+        // Whether the first line holds column names, which is skipped when reading and written when writing.
+        bool header = true;
+
+        arma::uword indexColumn = 0;
+        arma::uword valueColumn = 1;
+
+        // Unit of numeric timestamps, when reading a TimeSeries.
+        EpochUnit epochUnit = EpochUnit::seconds;
+
+        // Write a TimeSeries' timestamps as ISO 8601 rather than as ticks of its duration since the epoch.
+        bool writeIso8601 = true;
+
+        // Pool to parse chunks of the file on; nullptr parses on the calling thread.
+        ThreadPool *pool = nullptr;
+    };
+
+    namespace csv {
+
+        // Tick period of a time index, as in std::ratio.
+        struct Period {
+            std::int64_t num;
+            std::int64_t den;
+        };
+
+        /**
+         * Parse a number from [first, last), ignoring surrounding spaces; throws std::invalid_argument if it isn't one.
+         */
+        double parse_double(const char *first, const char *last);
+
+        /**
+         * Parse an ISO 8601 or epoch timestamp from [first, last) into ticks of period since the epoch; throws
+         * std::invalid_argument if it isn't one or the ticks don't fit in an int64.
+         */
+        std::int64_t parse_timestamp(const char *first, const char *last, CsvOptions::EpochUnit unit, Period period);
+
+        /**
+         * Index and values from a file, with timestamps parsed as ticks of period when it is given (non-zero), which
+         * the index keeps exactly.
+         */
+        Series read(const std::string &path, const CsvOptions &options, Period period);
+
+        /**
+         * Write index and values to a file, with the index written as timestamps of period when it is given (non-zero);
+         * throws std::invalid_argument, leaving the file untouched, if one of those isn't a finite tick count.
+         */
+        void write(const std::string &path, const Series &series, const CsvOptions &options, Period period);
+
+    }  // csv
+
+    Series read_csv(const std::string &path, const CsvOptions &options = CsvOptions());
+
+    void write_csv(const std::string &path, const Series &series, const CsvOptions &options = CsvOptions());
+
+    template<class TimePointType>
+    TimeSeries<TimePointType> read_csv_timeseries(const std::string &path, const CsvOptions &options = CsvOptions()) {
+        using Period = typename TimePointType::period;
+        return TimeSeries<TimePointType>::from_series(csv::read(path, options, {Period::num, Period::den}));
+    }
+
+    template<class TimePointType>
+    void write_csv(const std::string &path, const TimeSeries<TimePointType> &ts,
+                   const CsvOptions &options = CsvOptions()) {
+        using Period = typename TimePointType::period;
+        csv::write(path, ts, options, {Period::num, Period::den});
+    }
+
+}  // polars
+
+
+#endif //POLARS_CSVFILE_H
@@ -0,0 +1,252 @@
+#include "DataFrame.h"
+
+#include "numc.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace polars {
+
+    DataFrame::DataFrame() : t(arma::vec()) {}
+
+
+    DataFrame::DataFrame(const arma::vec &index) : t(index) {}
+
+
+    DataFrame::DataFrame(const SharedIndex &index) : t(index) {}
+
+
+    DataFrame::DataFrame(const std::vector<std::string> &names, const std::vector<Series> &columns)
+            : t(columns.empty() ? SharedIndex(arma::vec()) : columns.front().shared_index()) {
+        if (names.size() != columns.size()) {
+            throw std::invalid_argument("DataFrame: expected one name per column");
+        }
+        for (arma::uword i = 0; i < columns.size(); i++) {
+            add_column(names[i], columns[i]);
+        }
+    }
+
+
+    void DataFrame::add_column(const std::string &name, Series column) {
+        if (!column.shared_index().shares_memory_with(t)) {
+            if (data.empty() && t.size() == 0) {
+                // An empty DataFrame takes its index from its first column.
+                t = column.shared_index();
+            } else if (column.index().n_elem == t.size() && !arma::any(column.index() != *t)) {
+                // Same labels but a separate copy of them, so rebase the values onto the shared index.
+                column = Series(column.values(), t);
+            } else {
+                throw std::invalid_argument("DataFrame: column '" + name + "' does not have the DataFrame's index");
+            }
+        }
+
+        if (has_column(name)) {
+            data[position(name)] = std::move(column);
+        } else {
+            names.push_back(name);
+            data.push_back(std::move(column));
+        }
+    }
+
+
+    void DataFrame::add_column(const std::string &name, arma::vec values) {
+        if (values.n_elem != t.size()) {
+            throw std::invalid_argument("DataFrame: column '" + name + "' does not match the size of the index");
+        }
+        add_column(name, Series(std::move(values), t));
+    }
+
+
+    const Series &DataFrame::operator[](const std::string &name) const {
+        return column(name);
+    }
+
+
+    const Series &DataFrame::column(const std::string &name) const {
+        return data[position(name)];
+    }
+
+
+    bool DataFrame::has_column(const std::string &name) const {
+        return std::find(names.begin(), names.end(), name) != names.end();
+    }
+
+
+    arma::uword DataFrame::position(const std::string &name) const {
+        auto found = std::find(names.begin(), names.end(), name);
+        if (found == names.end()) {
+            throw std::out_of_range("DataFrame: no column '" + name + "'");
+        }
+        return found - names.begin();
+    }
+
+
+    const std::vector<std::string> &DataFrame::columns() const { return names; }
+
+
+    DataFrame::SeriesSize DataFrame::size() const { return t.size(); }
+
+
+    DataFrame::SeriesSize DataFrame::n_columns() const { return data.size(); }
+
+
+    bool DataFrame::empty() const { return size() == 0 || n_columns() == 0; }
+
+
+    const arma::vec &DataFrame::index() const { return *t; }
+
+
+    const SharedIndex &DataFrame::shared_index() const { return t; }
+
+
+    bool DataFrame::equals(const DataFrame &rhs) const {
+        if (names != rhs.names) return false;
+        if (size() != rhs.size()) return false;
+        if (!t.shares_memory_with(rhs.t) && arma::any(index() != rhs.index())) return false;
+        for (arma::uword i = 0; i < data.size(); i++) {
+            if (!polars::numc::equal_handling_nans(data[i].values(), rhs.data[i].values())) return false;
+        }
+        return true;
+    }
+
+
+    bool DataFrame::equal(const DataFrame &lhs, const DataFrame &rhs) {
+        return lhs.equals(rhs);
+    }
+
+
+    /**
+     * New DataFrame of f applied to each column, keeping the column names.
+     */
+    template<class F>
+    DataFrame DataFrame::map_columns(F f) const {
+        DataFrame result(t);
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result.add_column(names[i], f(data[i]));
+        }
+        return result;
+    }
+
+
+    DataFrame DataFrame::rolling(SeriesSize windowSize, const WindowProcessor &processor, SeriesSize minPeriods,
+                                 bool center, bool symmetric, WindowProcessor::WindowType win_type,
+                                 double alpha, ThreadPool &pool) const {
+        std::vector<Series> rolled = rolling_many(data, windowSize, processor, minPeriods, center, symmetric,
+                                                  win_type, alpha, pool);
+        DataFrame result(t);
+        for (arma::uword i = 0; i < rolled.size(); i++) {
+            result.add_column(names[i], rolled[i]);
+        }
+        return result;
+    }
+
+
+    DataFrame DataFrame::where(const SeriesMask &condition, double other) const {
+        return map_columns([&](const Series &column) {
+            return column.where(condition, other);
+        });
+    }
+
+
+    arma::vec DataFrame::count() const {
+        arma::vec result(data.size());
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result[i] = data[i].count();
+        }
+        return result;
+    }
+
+
+    arma::vec DataFrame::sum() const {
+        arma::vec result(data.size());
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result[i] = data[i].sum();
+        }
+        return result;
+    }
+
+
+    arma::vec DataFrame::mean() const {
+        arma::vec result(data.size());
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result[i] = data[i].mean();
+        }
+        return result;
+    }
+
+
+    arma::vec DataFrame::std(int ddof) const {
+        arma::vec result(data.size());
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result[i] = data[i].std(ddof);
+        }
+        return result;
+    }
+
+
+    DataFrame DataFrame::head(int n) const {
+        if (n < 0 || (arma::uword) n >= size()) {
+            return *this;
+        }
+        SharedIndex rows = t.head(n);
+        DataFrame result(rows);
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result.add_column(names[i], Series(data[i].values().head(n), rows));
+        }
+        return result;
+    }
+
+
+    DataFrame DataFrame::tail(int n) const {
+        if (n < 0 || (arma::uword) n >= size()) {
+            return *this;
+        }
+        SharedIndex rows = t.tail(n);
+        DataFrame result(rows);
+        for (arma::uword i = 0; i < data.size(); i++) {
+            result.add_column(names[i], Series(data[i].values().tail(n), rows));
+        }
+        return result;
+    }
+
+
+    /**
+     * Add support for pretty printing of a DataFrame object.
+     * @param os the output stream that will be written to
+     * @param df the DataFrame instance to output
+     * @return the ostream for further piping
+     */
+    std::ostream &operator<<(std::ostream &os, const DataFrame &df) {
+        os << "DataFrame:\nindex";
+        for (const std::string &name : df.columns()) {
+            os << "\t" << name;
+        }
+        os << "\n";
+        for (arma::uword row = 0; row < df.size(); row++) {
+            os << df.index()[row];
+            for (const std::string &name : df.columns()) {
+                os << "\t" << df[name].values()[row];
+            }
+            os << "\n";
+        }
+        return os;
+    }
+
+
+
+    std::vector<Series> rolling_many(const std::vector<Series> &series, Series::SeriesSize windowSize,
+                                     const WindowProcessor &processor, Series::SeriesSize minPeriods, bool center,
+                                     bool symmetric, WindowProcessor::WindowType win_type, double alpha,
+                                     ThreadPool &pool) {
+        // Each task writes only its own slot, so the output order is fixed regardless of scheduling. Long Series are
+        // further split into blocks on the same pool, which idle workers steal once the short ones are done.
+        std::vector<Series> results(series.size());
+        pool.parallel_for(series.size(), [&](arma::uword i) {
+            results[i] = series[i].rolling(windowSize, processor, minPeriods, center, symmetric, win_type, alpha,
+                                           &pool);
+        });
+        return results;
+    }
+
+}  // polars
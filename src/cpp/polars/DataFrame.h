@@ -0,0 +1,135 @@
+#ifndef POLARS_DATAFRAME_H
+#define POLARS_DATAFRAME_H
+
+#include "Series.h"
+#include "SeriesMask.h"
+#include "SharedIndex.h"
+#include "ThreadPool.h"
+#include "WindowProcessor.h"
+
+#include "armadillo"
+
+#include <string>
+#include <vector>
+
+
+namespace polars {
+
+    /**
+     * DataFrame
+     *
+     * Named columns of doubles over one index, inspired by a python pandas DataFrame.
+     *
+     * Every column is a Series that shares the DataFrame's SharedIndex, so the index is stored once however many
+     * columns there are, columns can be handed out as Series without copying, and operations between columns take the
+     * O(1) aligned path.
+     */
+    class DataFrame {
+    public:
+        typedef arma::uword SeriesSize;
+
+        DataFrame();
+
+        explicit DataFrame(const arma::vec &index);
+
+        explicit DataFrame(const SharedIndex &index);
+
+        /**
+         * Build from columns that all have the same index; the first column's index is shared by the others.
+         */
+        DataFrame(const std::vector<std::string> &names, const std::vector<Series> &columns);
+
+        /**
+         * Add a column, replacing any existing column of the same name. The column must have the DataFrame's index.
+         * A column moved in keeps its values without copying them.
+         */
+        void add_column(const std::string &name, Series column);
+
+        void add_column(const std::string &name, arma::vec values);
+
+        const Series &operator[](const std::string &name) const;
+
+        const Series &column(const std::string &name) const;
+
+        bool has_column(const std::string &name) const;
+
+        const std::vector<std::string> &columns() const;
+
+        SeriesSize size() const;
+
+        SeriesSize n_columns() const;
+
+        bool empty() const;
+
+        const arma::vec &index() const;
+
+        const SharedIndex &shared_index() const;
+
+        bool equals(const DataFrame &rhs) const;
+
+        static bool equal(const DataFrame &lhs, const DataFrame &rhs);
+
+        /**
+         * Rolling of every column, with the columns spread across pool.
+         */
+        DataFrame rolling(SeriesSize windowSize,
+                          const WindowProcessor &processor,
+                          SeriesSize minPeriods = 0, /* 0 treated as windowSize */
+                          bool center = true,
+                          bool symmetric = false,
+                          WindowProcessor::WindowType win_type = WindowProcessor::WindowType::none,
+                          double alpha = -1,
+                          ThreadPool &pool = ThreadPool::global()) const;
+
+        DataFrame where(const SeriesMask &condition, double other = NAN) const;
+
+        // column-wise reductions, in the order of columns().
+        arma::vec count() const;
+
+        arma::vec sum() const;
+
+        arma::vec mean() const;
+
+        arma::vec std(int ddof = 1) const;
+
+        /**
+         * First n rows; all of them when n is negative or at least the number of rows, as Series::head does.
+         */
+        DataFrame head(int n = 5) const;
+
+        /**
+         * Last n rows, handling n as head does.
+         */
+        DataFrame tail(int n = 5) const;
+
+    private:
+        template<class F>
+        DataFrame map_columns(F f) const;
+
+        arma::uword position(const std::string &name) const;
+
+        SharedIndex t;
+        std::vector<std::string> names;
+        std::vector<Series> data;
+    };
+
+    std::ostream &operator<<(std::ostream &os, const DataFrame &df);
+
+    /**
+     * Series::rolling of many independent Series in parallel across pool, which also splits long Series into blocks.
+     * The results are in the same order as the input whatever order they are computed in.
+     */
+    std::vector<Series> rolling_many(const std::vector<Series> &series,
+                                     Series::SeriesSize windowSize,
+                                     const WindowProcessor &processor,
+                                     Series::SeriesSize minPeriods = 0, /* 0 treated as windowSize */
+                                     bool center = true,
+                                     bool symmetric = false,
+                                     WindowProcessor::WindowType win_type = WindowProcessor::WindowType::none,
+                                     double alpha = -1,
+                                     ThreadPool &pool = ThreadPool::global());
+
+}  // polars
+
+
+#endif //POLARS_DATAFRAME_H
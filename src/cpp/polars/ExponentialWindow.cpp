@@ -0,0 +1,199 @@
+#include "ExponentialWindow.h"
+
+#include "Instrumentation.h"
+#include "Series.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace polars {
+
+    Decay::Decay(double alpha) : alpha_(alpha) {
+        if (!(alpha > 0 && alpha <= 1)) {
+            throw std::invalid_argument("Decay: alpha must be in (0, 1]");
+        }
+    }
+
+    Decay Decay::alpha(double alpha) {
+        return Decay(alpha);
+    }
+
+    Decay Decay::com(double com) {
+        if (!(com >= 0)) {
+            throw std::invalid_argument("Decay: com must be >= 0");
+        }
+        return Decay(1. / (1. + com));
+    }
+
+    Decay Decay::span(double span) {
+        if (!(span >= 1)) {
+            throw std::invalid_argument("Decay: span must be >= 1");
+        }
+        return Decay(2. / (span + 1.));
+    }
+
+    Decay Decay::halflife(double halflife) {
+        if (!(halflife > 0)) {
+            throw std::invalid_argument("Decay: halflife must be positive");
+        }
+        return Decay(1. - std::exp(-std::log(2.) / halflife));
+    }
+
+    double Decay::smoothing() const {
+        return alpha_;
+    }
+
+
+    Series ExponentialWindow::mean() const {
+        POLARS_INSTRUMENT("ExponentialWindow::mean");
+        const arma::vec &x = ts_.values();
+        arma::uword n = x.n_elem;
+        arma::uword minPeriods = std::max<arma::uword>(minPeriods_, 1);
+        arma::vec result(n);
+
+        // Same recursion as pandas: `weighted` is the mean so far and `oldWeight` the total weight of the values in it.
+        double oldWeightFactor = 1 - alpha_;
+        double newWeight = adjust_ ? 1 : alpha_;
+        double weighted = NAN;
+        double oldWeight = 1;
+        arma::uword observations = 0;
+
+        for (arma::uword i = 0; i < n; i++) {
+            double value = x[i];
+            bool observation = std::isfinite(value);
+            observations += observation;
+
+            if (std::isnan(weighted)) {
+                if (observation) {
+                    weighted = value;
+                }
+            } else if (observation || !ignoreNA_) {
+                oldWeight *= oldWeightFactor;
+                if (observation) {
+                    // Avoid rounding creeping into a constant series.
+                    if (weighted != value) {
+                        weighted = (oldWeight * weighted + newWeight * value) / (oldWeight + newWeight);
+                    }
+                    oldWeight = adjust_ ? oldWeight + newWeight : 1;
+                }
+            }
+
+            result[i] = observations >= minPeriods ? weighted : NAN;
+        }
+
+        return Series(std::move(result), ts_.shared_index());
+    }
+
+
+    arma::vec ExponentialWindow::covariance(const arma::vec &x, const arma::vec &y, bool bias) const {
+        arma::uword n = x.n_elem;
+        arma::uword minPeriods = std::max<arma::uword>(minPeriods_, 1);
+        arma::vec result(n);
+
+        // Weighted means and covariance so far, and the sum of the weights and of their squares for the bias correction.
+        double oldWeightFactor = 1 - alpha_;
+        double newWeight = adjust_ ? 1 : alpha_;
+        double meanX = NAN;
+        double meanY = NAN;
+        double cov = 0;
+        double sumWeights = 1;
+        double sumSquaredWeights = 1;
+        double oldWeight = 1;
+        arma::uword observations = 0;
+
+        for (arma::uword i = 0; i < n; i++) {
+            double valueX = x[i];
+            double valueY = y[i];
+            bool observation = std::isfinite(valueX) && std::isfinite(valueY);
+            observations += observation;
+
+            if (std::isnan(meanX)) {
+                if (observation) {
+                    meanX = valueX;
+                    meanY = valueY;
+                }
+            } else if (observation || !ignoreNA_) {
+                sumWeights *= oldWeightFactor;
+                sumSquaredWeights *= oldWeightFactor * oldWeightFactor;
+                oldWeight *= oldWeightFactor;
+                if (observation) {
+                    double oldMeanX = meanX;
+                    double oldMeanY = meanY;
+                    if (meanX != valueX) {
+                        meanX = (oldWeight * oldMeanX + newWeight * valueX) / (oldWeight + newWeight);
+                    }
+                    if (meanY != valueY) {
+                        meanY = (oldWeight * oldMeanY + newWeight * valueY) / (oldWeight + newWeight);
+                    }
+                    cov = (oldWeight * (cov + (oldMeanX - meanX) * (oldMeanY - meanY)) +
+                           newWeight * (valueX - meanX) * (valueY - meanY)) / (oldWeight + newWeight);
+                    sumWeights += newWeight;
+                    sumSquaredWeights += newWeight * newWeight;
+                    oldWeight += newWeight;
+                    if (!adjust_) {
+                        sumWeights /= oldWeight;
+                        sumSquaredWeights /= oldWeight * oldWeight;
+                        oldWeight = 1;
+                    }
+                }
+            }
+
+            if (observations < minPeriods) {
+                result[i] = NAN;
+            } else if (bias) {
+                result[i] = cov;
+            } else {
+                double numerator = sumWeights * sumWeights;
+                double denominator = numerator - sumSquaredWeights;
+                result[i] = denominator > 0 ? numerator / denominator * cov : NAN;
+            }
+        }
+
+        return result;
+    }
+
+
+    Series ExponentialWindow::var(bool bias) const {
+        POLARS_INSTRUMENT("ExponentialWindow::var");
+        return Series(covariance(ts_.values(), ts_.values(), bias), ts_.shared_index());
+    }
+
+
+    Series ExponentialWindow::std(bool bias) const {
+        POLARS_INSTRUMENT("ExponentialWindow::std");
+        return Series(arma::sqrt(covariance(ts_.values(), ts_.values(), bias)), ts_.shared_index());
+    }
+
+
+    Series ExponentialWindow::cov(const Series &other, bool bias) const {
+        POLARS_INSTRUMENT("ExponentialWindow::cov");
+        if (!ts_.is_aligned_with(other)) {
+            auto aligned = ts_.align(other);
+            return Series(covariance(aligned.first.values(), aligned.second.values(), bias),
+                          aligned.first.shared_index());
+        }
+        return Series(covariance(ts_.values(), other.values(), bias), ts_.shared_index());
+    }
+
+
+    Series ExponentialWindow::corr(const Series &other) const {
+        POLARS_INSTRUMENT("ExponentialWindow::corr");
+        if (!ts_.is_aligned_with(other)) {
+            auto aligned = ts_.align(other);
+            return ExponentialWindow(aligned.first, Decay::alpha(alpha_), adjust_, ignoreNA_, minPeriods_).corr(
+                    aligned.second);
+        }
+
+        // As in pandas, both inputs skip the union of their NANs, so that the variances weight the same observations
+        // as the covariance. Adding 0 * the other input carries its NANs (and infinities) across.
+        arma::vec x = ts_.values() + 0 * other.values();
+        arma::vec y = other.values() + 0 * ts_.values();
+        arma::vec cov = covariance(x, y, true);
+        arma::vec varX = covariance(x, x, true);
+        arma::vec varY = covariance(y, y, true);
+        return Series(cov / arma::sqrt(varX % varY), ts_.shared_index());
+    }
+
+}  // polars
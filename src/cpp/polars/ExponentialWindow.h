@@ -0,0 +1,91 @@
+#ifndef POLARS_EXPONENTIALWINDOW_H
+#define POLARS_EXPONENTIALWINDOW_H
+
+#include "armadillo"
+
+
+namespace polars {
+    class Series;
+
+    /**
+     * Decay of an exponentially weighted window, given in any of the ways pandas' ewm() accepts. Each is converted to
+     * the smoothing factor alpha in (0, 1]:
+     *
+     *     com:      alpha = 1 / (1 + com)                  com >= 0
+     *     span:     alpha = 2 / (span + 1)                 span >= 1
+     *     halflife: alpha = 1 - exp(-ln(2) / halflife)     halflife > 0
+     */
+    class Decay {
+    public:
+        static Decay alpha(double alpha);
+
+        static Decay com(double com);
+
+        static Decay span(double span);
+
+        static Decay halflife(double halflife);
+
+        double smoothing() const;
+
+    private:
+        explicit Decay(double alpha);
+
+        double alpha_;
+    };
+
+    /**
+     * Exponentially weighted statistics of a Series, like pandas' ewm(). Each is computed by the usual O(n) recursion
+     * rather than by rolling a window over the whole history, and follows pandas for the options:
+     *
+     *     adjust:     true divides by the sum of the weights, (1 - alpha)^i, seen so far; false uses the recursion
+     *                 y_t = (1 - alpha) * y_(t-1) + alpha * x_t.
+     *     ignoreNA:   false decays the weights by the absolute position of the values, so NANs still age the older
+     *                 values; true only counts the finite values.
+     *     minPeriods: results are NAN until this many finite values have been seen (0 is treated as 1).
+     *
+     * After the first finite value a NAN in the input repeats the previous result.
+     */
+    class ExponentialWindow {
+    public:
+        ExponentialWindow(
+                const Series &ts,
+                Decay decay,
+                bool adjust = true,
+                bool ignoreNA = false,
+                arma::uword minPeriods = 0)
+                :
+                ts_(ts),
+                alpha_(decay.smoothing()),
+                adjust_(adjust),
+                ignoreNA_(ignoreNA),
+                minPeriods_(minPeriods)
+        {};
+
+        Series mean() const;
+
+        Series var(bool bias = false) const;
+
+        Series std(bool bias = false) const;
+
+        /**
+         * Exponentially weighted covariance with other, which is aligned to this Series first if the indices differ.
+         * Only the positions where both are finite count as observations.
+         */
+        Series cov(const Series &other, bool bias = false) const;
+
+        Series corr(const Series &other) const;
+
+    private:
+        arma::vec covariance(const arma::vec &x, const arma::vec &y, bool bias) const;
+
+        const Series &ts_;
+        double alpha_;
+        bool adjust_;
+        bool ignoreNA_;
+        arma::uword minPeriods_;
+    };
+
+}  // polars
+
+
+#endif //POLARS_EXPONENTIALWINDOW_H
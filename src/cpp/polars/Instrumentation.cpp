@@ -0,0 +1,185 @@
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <new>
+
+
+namespace polars {
+
+    namespace instrumentation {
+
+#ifdef POLARS_INSTRUMENTATION
+
+        namespace {
+
+            // Plain data so that counting an allocation never allocates or needs constructing first.
+            struct ThreadCounters {
+                std::uint64_t allocations;
+                std::uint64_t bytes;
+                bool paused;
+            };
+
+            thread_local ThreadCounters counters;
+
+            struct Registry {
+                std::mutex mutex;
+                std::map<std::string, OperationStats> operations;
+            };
+
+            Registry &registry() {
+                static Registry *instance = new Registry();  // never destroyed, as scopes may end during exit
+                return *instance;
+            }
+
+            std::int64_t now() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+        }  // namespace
+
+        void count_allocation(std::size_t bytes) {
+            if (!counters.paused) {
+                counters.allocations++;
+                counters.bytes += bytes;
+            }
+        }
+
+        AllocationCount thread_allocations() {
+            return {counters.allocations, counters.bytes};
+        }
+
+        void charge_allocations(const AllocationCount &count) {
+            counters.allocations += count.allocations;
+            counters.bytes += count.bytes;
+        }
+
+        void uncharge_allocations(const AllocationCount &count) {
+            counters.allocations -= count.allocations;
+            counters.bytes -= count.bytes;
+        }
+
+        Scope::Scope(const char *name) : name(name), allocations(counters.allocations), bytes(counters.bytes),
+                                         start(now()) {}
+
+        Scope::~Scope() {
+            double seconds = (now() - start) * 1e-9;
+            std::uint64_t scopeAllocations = counters.allocations - allocations;
+            std::uint64_t scopeBytes = counters.bytes - bytes;
+
+            // Adding to the registry allocates, which shouldn't be charged to any enclosing scope.
+            bool paused = counters.paused;
+            counters.paused = true;
+            {
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                OperationStats &stats = r.operations[name];
+                stats.name = name;
+                stats.calls++;
+                stats.allocations += scopeAllocations;
+                stats.bytes += scopeBytes;
+                stats.seconds += seconds;
+            }
+            counters.paused = paused;
+        }
+
+        std::vector<OperationStats> report() {
+            std::vector<OperationStats> result;
+            {
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                for (const auto &operation : r.operations) {
+                    result.push_back(operation.second);
+                }
+            }
+            std::sort(result.begin(), result.end(), [](const OperationStats &a, const OperationStats &b) {
+                return a.bytes > b.bytes;
+            });
+            return result;
+        }
+
+        void reset() {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.operations.clear();
+        }
+
+#else
+
+        std::vector<OperationStats> report() {
+            return {};
+        }
+
+        void reset() {}
+
+#endif
+
+        void dump(std::ostream &os) {
+            os << std::left << std::setw(40) << "operation" << std::right << std::setw(12) << "calls"
+               << std::setw(14) << "allocations" << std::setw(16) << "bytes" << std::setw(14) << "seconds" << "\n";
+            for (const OperationStats &stats : report()) {
+                os << std::left << std::setw(40) << stats.name << std::right << std::setw(12) << stats.calls
+                   << std::setw(14) << stats.allocations << std::setw(16) << stats.bytes << std::setw(14)
+                   << std::fixed << std::setprecision(6) << stats.seconds << "\n";
+            }
+        }
+
+    }  // instrumentation
+
+}  // polars
+
+
+#ifdef POLARS_INSTRUMENTATION
+
+void *polars_instrumented_alloc(std::size_t bytes) {
+    polars::instrumentation::count_allocation(bytes);
+    return std::malloc(bytes);
+}
+
+// Every operator delete below frees through here. Inlined into them, GCC sees memory from operator new reach free and
+// warns, but that memory came from malloc in polars_instrumented_alloc.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void polars_instrumented_free(void *memory) {
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+void *operator new(std::size_t bytes) {
+    void *memory = polars_instrumented_alloc(bytes == 0 ? 1 : bytes);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void *operator new[](std::size_t bytes) {
+    return operator new(bytes);
+}
+
+void operator delete(void *memory) noexcept {
+    polars_instrumented_free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    polars_instrumented_free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    polars_instrumented_free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    polars_instrumented_free(memory);
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef POLARS_INSTRUMENTATION_H
+#define POLARS_INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Opt-in counters of calls, heap allocations and wall time per public polars operation, to find the hot spots of a
+ * pipeline without an external profiler.
+ *
+ * Build with -DPOLARS_INSTRUMENTATION=ON (which defines POLARS_INSTRUMENTATION) to turn them on. Otherwise
+ * POLARS_INSTRUMENT expands to nothing, no allocator is replaced and report() is always empty.
+ *
+ * When on, the global operator new/delete are replaced to count allocations, and Armadillo's element buffers are
+ * counted through its ARMA_ALIEN_MEM_ALLOC_FUNCTION hook. As those operators are global, this applies to the whole
+ * process that links polars, not just to polars itself. This header has to be seen before armadillo for that, so
+ * CMake force-includes it. Figures are inclusive: Rolling::mean also counts the Series::rolling it calls, including the
+ * allocations made for it on ThreadPool workers. Bytes are those allocated, which for polars' copy-on-return methods is
+ * also what they copy.
+ *
+ * The operations covered are the public methods of Series, SeriesMask, Rolling, OffsetRolling, Window and
+ * ExponentialWindow that allocate their result.
+ */
+namespace polars {
+
+    namespace instrumentation {
+
+        struct OperationStats {
+            std::string name;
+            std::uint64_t calls;
+            std::uint64_t allocations;
+            std::uint64_t bytes;
+            double seconds;
+        };
+
+        // Totals for every operation called since the last reset, the most bytes first.
+        std::vector<OperationStats> report();
+
+        // report() as a table.
+        void dump(std::ostream &os);
+
+        void reset();
+
+#ifdef POLARS_INSTRUMENTATION
+        void count_allocation(std::size_t bytes);
+
+        struct AllocationCount {
+            std::uint64_t allocations;
+            std::uint64_t bytes;
+        };
+
+        // Allocations counted on the calling thread so far.
+        AllocationCount thread_allocations();
+
+        /**
+         * Move allocations counted on the calling thread to or from it, e.g. so that those made by a ThreadPool worker
+         * on behalf of parallel_for are charged to its caller's scopes.
+         */
+        void charge_allocations(const AllocationCount &count);
+
+        void uncharge_allocations(const AllocationCount &count);
+
+        // Measures the enclosing block as one call of the named operation.
+        class Scope {
+        public:
+            explicit Scope(const char *name);
+
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            const char *name;
+            std::uint64_t allocations;
+            std::uint64_t bytes;
+            std::int64_t start;
+        };
+#endif
+
+    }  // instrumentation
+
+}  // polars
+
+
+#ifdef POLARS_INSTRUMENTATION
+
+void *polars_instrumented_alloc(std::size_t bytes);
+
+void polars_instrumented_free(void *memory);
+
+#ifndef ARMA_ALIEN_MEM_ALLOC_FUNCTION
+#define ARMA_ALIEN_MEM_ALLOC_FUNCTION polars_instrumented_alloc
+#define ARMA_ALIEN_MEM_FREE_FUNCTION polars_instrumented_free
+#endif
+
+#define POLARS_INSTRUMENT_CONCAT(a, b) a##b
+#define POLARS_INSTRUMENT_SCOPE(name, line) \
+    polars::instrumentation::Scope POLARS_INSTRUMENT_CONCAT(polars_instrument_scope_, line)(name)
+#define POLARS_INSTRUMENT(name) POLARS_INSTRUMENT_SCOPE(name, __LINE__)
+
+#else
+
+#define POLARS_INSTRUMENT(name)
+
+#endif
+
+
+#endif //POLARS_INSTRUMENTATION_H
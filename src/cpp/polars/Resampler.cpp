@@ -0,0 +1,169 @@
+#include "Resampler.h"
+
+#include "Series.h"
+
+#include <cmath>
+#include <stdexcept>
+
+
+namespace polars {
+
+    Resampler::Resampler(const Series &ts, double width) : ts_(ts), width_(width) {
+        if (!(width > 0)) {
+            throw std::invalid_argument("Resampler: width must be positive");
+        }
+        if (!ts.shared_index().is_sorted()) {
+            throw std::invalid_argument("Resampler: the index must be sorted");
+        }
+    }
+
+
+    Resampler::Buckets Resampler::buckets() const {
+        const arma::vec &index = ts_.index();
+        arma::uword n = index.n_elem;
+        if (n == 0) {
+            return {SharedIndex(arma::vec()), arma::uvec({0})};
+        }
+
+        double first_bucket = std::floor(index[0] / width_);
+        arma::uword n_buckets = std::floor(index[n - 1] / width_) - first_bucket + 1;
+
+        arma::vec labels(n_buckets);
+        arma::uvec offsets(n_buckets + 1);
+        arma::uword position = 0;
+        for (arma::uword k = 0; k < n_buckets; k++) {
+            labels[k] = (first_bucket + k) * width_;
+            offsets[k] = position;
+
+            double bucket_end = (first_bucket + k + 1) * width_;
+            while (position < n && index[position] < bucket_end) {
+                position++;
+            }
+        }
+        offsets[n_buckets] = n;
+
+        return {SharedIndex(std::move(labels)), offsets};
+    }
+
+
+    template<class Aggregate>
+    Series Resampler::aggregate(Aggregate f) const {
+        Buckets b = buckets();
+        const double *values = ts_.values().memptr();
+
+        arma::uword n_buckets = b.labels->n_elem;
+        arma::vec result(n_buckets);
+        for (arma::uword k = 0; k < n_buckets; k++) {
+            result[k] = f(values + b.offsets[k], values + b.offsets[k + 1]);
+        }
+        return Series(std::move(result), b.labels);
+    }
+
+
+    Series Resampler::sum() const {
+        return aggregate([](const double *begin, const double *end) {
+            double sum = 0;
+            for (const double *it = begin; it != end; it++) {
+                if (std::isfinite(*it)) sum += *it;
+            }
+            return sum;
+        });
+    }
+
+
+    Series Resampler::mean() const {
+        return aggregate([](const double *begin, const double *end) {
+            double sum = 0;
+            arma::uword count = 0;
+            for (const double *it = begin; it != end; it++) {
+                if (std::isfinite(*it)) {
+                    sum += *it;
+                    count++;
+                }
+            }
+            return count > 0 ? sum / count : NAN;
+        });
+    }
+
+
+    Series Resampler::min() const {
+        return aggregate([](const double *begin, const double *end) {
+            double result = NAN;
+            for (const double *it = begin; it != end; it++) {
+                if (std::isfinite(*it) && !(result <= *it)) result = *it;
+            }
+            return result;
+        });
+    }
+
+
+    Series Resampler::max() const {
+        return aggregate([](const double *begin, const double *end) {
+            double result = NAN;
+            for (const double *it = begin; it != end; it++) {
+                if (std::isfinite(*it) && !(result >= *it)) result = *it;
+            }
+            return result;
+        });
+    }
+
+
+    Series Resampler::first() const {
+        return aggregate([](const double *begin, const double *end) {
+            for (const double *it = begin; it != end; it++) {
+                if (std::isfinite(*it)) return *it;
+            }
+            return (double) NAN;
+        });
+    }
+
+
+    Series Resampler::last() const {
+        return aggregate([](const double *begin, const double *end) {
+            for (const double *it = end; it != begin; it--) {
+                if (std::isfinite(*(it - 1))) return *(it - 1);
+            }
+            return (double) NAN;
+        });
+    }
+
+
+    Series Resampler::count() const {
+        return aggregate([](const double *begin, const double *end) {
+            double count = 0;
+            for (const double *it = begin; it != end; it++) {
+                if (std::isfinite(*it)) count++;
+            }
+            return count;
+        });
+    }
+
+
+    OHLC<Series> Resampler::ohlc() const {
+        Buckets b = buckets();
+        const arma::vec &values = ts_.values();
+
+        arma::uword n_buckets = b.labels->n_elem;
+        arma::vec open(n_buckets), high(n_buckets), low(n_buckets), close(n_buckets);
+        open.fill(NAN);
+        high.fill(NAN);
+        low.fill(NAN);
+        close.fill(NAN);
+
+        // All four in the same pass over the values.
+        for (arma::uword k = 0; k < n_buckets; k++) {
+            for (arma::uword i = b.offsets[k]; i < b.offsets[k + 1]; i++) {
+                double value = values[i];
+                if (!std::isfinite(value)) continue;
+                if (std::isnan(open[k])) open[k] = value;
+                if (!(high[k] >= value)) high[k] = value;
+                if (!(low[k] <= value)) low[k] = value;
+                close[k] = value;
+            }
+        }
+
+        return {Series(std::move(open), b.labels), Series(std::move(high), b.labels),
+                Series(std::move(low), b.labels), Series(std::move(close), b.labels)};
+    }
+
+}  // polars
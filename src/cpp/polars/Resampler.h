@@ -0,0 +1,65 @@
+#ifndef POLARS_RESAMPLER_H
+#define POLARS_RESAMPLER_H
+
+#include "SharedIndex.h"
+
+#include "armadillo"
+
+
+namespace polars {
+    class Series;
+
+    /**
+     * Open / high / low / close of each bucket, as four series sharing one index.
+     */
+    template<class SeriesType>
+    struct OHLC {
+        SeriesType open;
+        SeriesType high;
+        SeriesType low;
+        SeriesType close;
+    };
+
+    /**
+     * Downsampling of a Series into fixed-width buckets of its index, like pandas' resample().
+     *
+     * Bucket k covers the labels in [k * width, (k + 1) * width) and is labelled with its start. Every bucket from the
+     * first label to the last is returned, including empty ones, and NANs are ignored: empty buckets are 0 for sum and
+     * count, and NAN otherwise.
+     *
+     * The index must be sorted, so each bucket is a contiguous run of values and all the buckets are found in a single
+     * linear pass, without going through a std::map.
+     */
+    class Resampler {
+    public:
+        Resampler(const Series &ts, double width);
+
+        Series sum() const;
+        Series mean() const;
+        Series min() const;
+        Series max() const;
+        Series first() const;
+        Series last() const;
+        Series count() const;
+        OHLC<Series> ohlc() const;
+
+    private:
+        // Bucket labels, and the positions of the values in bucket k as [offsets[k], offsets[k + 1]).
+        struct Buckets {
+            SharedIndex labels;
+            arma::uvec offsets;
+        };
+
+        Buckets buckets() const;
+
+        template<class Aggregate>
+        Series aggregate(Aggregate f) const;
+
+        const Series &ts_;
+        double width_;
+    };
+
+}  // polars
+
+
+#endif //POLARS_RESAMPLER_H
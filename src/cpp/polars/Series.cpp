@@ -18,16 +18,24 @@
 
 #include "Series.h"
 
+#include "Instrumentation.h"
 #include "SeriesMask.h"
+#include "ThreadPool.h"
 #include "numc.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
 
 namespace polars {
 
 
     using SeriesMask = polars::SeriesMask;
 
-    Series::Series() = default;
+    Series::Series() : t(arma::vec()) {}
 
 
 // todo; check for 1-D series & that the lengths match
@@ -36,19 +44,29 @@ namespace polars {
         //assert(t.n_rows == v.n_rows);
     };
 
+    /**
+     * Construct a Series that shares its index with existing Series / SeriesMasks rather than copying it.
+     */
+    Series::Series(arma::vec v, const SharedIndex &t) : t(t), v(std::move(v)) {
+        //assert(t->n_rows == v.n_rows);
+    };
+
     /**
      * Converting constructor - this takes a SeriesMask and creates a Series from it.
      *
      * This is intentionally implicit (not marked explicit) so that a function expecting a Series can be passed a
      * SeriesMask and it will be automatically converted since this is a loss-less process.
      */
-    Series::Series(const SeriesMask &sm) : t(sm.index()), v(arma::conv_to<arma::vec>::from(sm.values())) {}
+    Series::Series(const SeriesMask &sm) : t(sm.t), v(sm.size(), arma::fill::zeros) {
+        sm.v.for_each_set([this](arma::uword i) { v[i] = 1; });
+    }
 
     Series Series::from_vect(const std::vector<double> &t_v, const std::vector<double> &v_v) {
         return Series(arma::conv_to<arma::vec>::from(v_v), arma::conv_to<arma::vec>::from(t_v));
     }
 
     Series Series::from_map(const std::map<double, double> &iv_map) {
+        POLARS_INSTRUMENT("Series::from_map");
         arma::vec index(iv_map.size());
         arma::vec values(iv_map.size());
         int i = 0;
@@ -63,93 +81,120 @@ namespace polars {
 
 // Series [op] int methods
     SeriesMask Series::operator==(const int rhs) const {
-        arma::vec rhs_vec = arma::ones(this->size()) * rhs;
-        arma::vec abs_diff = arma::abs(values() - rhs_vec);
+        arma::vec abs_diff = arma::abs(v - rhs);
         // We can't use a large difference test like .1 despite the rhs is an int since the lhs is double so could be close.
         double threshold = 1E-50;
-        return SeriesMask(abs_diff < threshold, index());
+        return SeriesMask(abs_diff < threshold, t);
     }
 
 
     SeriesMask Series::operator!=(const int rhs) const {  // TODO implement as negation of operator==
-        arma::vec rhs_vec = arma::ones(this->size()) * rhs;
-        arma::vec abs_diff = arma::abs(values() - rhs_vec);
+        arma::vec abs_diff = arma::abs(v - rhs);
         // We can't use a large difference test like .1 despite the rhs is an int since the lhs is double so could be close.
         double threshold = 1E-50;
-        return SeriesMask(abs_diff > threshold, index());
+        return SeriesMask(abs_diff > threshold, t);
     }
 
 
     // Series [op] Series methods
+    //
+    // Operands with different indices are aligned first, as in pandas: arithmetic takes the outer join, filling labels
+    // missing from one side with NAN, while comparisons take the inner join since a SeriesMask has no missing value.
     SeriesMask Series::operator==(const Series &rhs) const {
-        // TODO: make this fast enough to always check at runtime
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask(values() == rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator==");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::inner);
+            return aligned.first == aligned.second;
+        }
+        return SeriesMask(v == rhs.v, t);
     }
 
 
     SeriesMask Series::operator!=(const Series &rhs) const {
-        // TODO: make this fast enough to always check at runtime
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask(values() != rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator!=");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::inner);
+            return aligned.first != aligned.second;
+        }
+        return SeriesMask(v != rhs.v, t);
     }
 
 
     SeriesMask Series::operator>(const Series &rhs) const {
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask(values() > rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator>");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::inner);
+            return aligned.first > aligned.second;
+        }
+        return SeriesMask(v > rhs.v, t);
     }
 
 
     SeriesMask Series::operator<(const Series &rhs) const {
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return polars::SeriesMask(values() < rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator<");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::inner);
+            return aligned.first < aligned.second;
+        }
+        return SeriesMask(v < rhs.v, t);
     }
 
 
     Series Series::operator+(const Series &rhs) const {
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return polars::Series(values() + rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator+");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::outer);
+            return aligned.first + aligned.second;
+        }
+        return Series(v + rhs.v, t);
     }
 
 
     Series Series::operator-(const Series &rhs) const {
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return polars::Series(values() - rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator-");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::outer);
+            return aligned.first - aligned.second;
+        }
+        return Series(v - rhs.v, t);
     }
 
 
     Series Series::operator*(const Series &rhs) const {
-        //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return polars::Series(values() % rhs.values(), index());
+        POLARS_INSTRUMENT("Series::operator*");
+        if (!is_aligned_with(rhs)) {
+            auto aligned = align(rhs, Join::outer);
+            return aligned.first * aligned.second;
+        }
+        return Series(v % rhs.v, t);
     }
 
 
 // Series [op] double methods
     SeriesMask Series::operator>(const double &rhs) const {
-        return SeriesMask(values() > (arma::ones(size()) * rhs), index());
+        return SeriesMask(v > rhs, t);
     }
 
     SeriesMask Series::operator>=(const double &rhs) const {
-        return SeriesMask(values() >= (arma::ones(size()) * rhs), index());
+        return SeriesMask(v >= rhs, t);
     }
 
     SeriesMask Series::operator<=(const double &rhs) const {
-        return SeriesMask(values() <= (arma::ones(size()) * rhs), index());
+        return SeriesMask(v <= rhs, t);
     }
 
     Series Series::operator+(const double &rhs) const {
-        return Series(values() + rhs, index());
+        return Series(values() + rhs, t);
     }
 
 
     Series Series::operator-(const double &rhs) const {
-        return Series(values() - rhs, index());
+        return Series(values() - rhs, t);
     }
 
 
     Series Series::operator*(const double &rhs) const {
-        return Series(values() * rhs, index());
+        return Series(values() * rhs, t);
     }
 
 
@@ -158,7 +203,7 @@ namespace polars {
         if ((index().n_rows != rhs.index().n_rows)) return false;
         if ((index().n_cols != rhs.index().n_cols)) return false;
         if (!polars::numc::equal_handling_nans(values(), rhs.values())) return false;
-        if (any(index() != rhs.index())) return false;
+        if (!t.shares_memory_with(rhs.t) && any(index() != rhs.index())) return false;
         return true;
     }
 
@@ -168,13 +213,139 @@ namespace polars {
         if ((index().n_rows != rhs.index().n_rows)) return false;
         if ((index().n_cols != rhs.index().n_cols)) return false;
         if (!polars::numc::almost_equal_handling_nans(values(), rhs.values())) return false;
-        if (any(index() != rhs.index())) return false;
+        if (!t.shares_memory_with(rhs.t) && any(index() != rhs.index())) return false;
         return true;
     }
 
+// Alignment.
+
+    /**
+     * True if rhs has the same index as this Series, in which case element-wise operations can use the values as they
+     * are. Series derived from one another share their index, which makes this check O(1); otherwise the indices are
+     * compared element by element.
+     */
+    bool Series::is_aligned_with(const Series &rhs) const {
+        if (t.shares_memory_with(rhs.t)) return true;
+        if (t.size() != rhs.t.size()) return false;
+        if (t.has_ticks() && rhs.t.has_ticks()) {
+            // Exact, and without building the labels of either.
+            return std::equal(t.ticks(), t.ticks() + t.size(), rhs.t.ticks());
+        }
+        return !arma::any(index() != rhs.index());  // Use not any != to handle empty array case
+    }
+
+    namespace {
+
+        const arma::uword missing_position = std::numeric_limits<arma::uword>::max();
+
+        // Orders labels with NANs last.
+        inline bool _label_less(double a, double b) {
+            return a < b || (!std::isnan(a) && std::isnan(b));
+        }
+
+        // Positions that visit the index in label order.
+        std::vector<arma::uword> _sorted_positions(const SharedIndex &index) {
+            std::vector<arma::uword> positions(index->n_elem);
+            for (arma::uword i = 0; i < positions.size(); i++) {
+                positions[i] = i;
+            }
+            if (!index.is_sorted()) {
+                const double *labels = index->memptr();
+                std::stable_sort(positions.begin(), positions.end(), [labels](arma::uword a, arma::uword b) {
+                    return _label_less(labels[a], labels[b]);
+                });
+            }
+            return positions;
+        }
+
+        arma::vec _take(const arma::vec &values, const std::vector<arma::uword> &positions) {
+            arma::vec result(positions.size());
+            for (arma::uword i = 0; i < positions.size(); i++) {
+                result[i] = positions[i] == missing_position ? NAN : values[positions[i]];
+            }
+            return result;
+        }
+
+    }  // namespace
+
+    /**
+     * Reindex this Series and other onto a common index, like pandas.Series.align.
+     *
+     * If the indices already match, both results share this Series' index. Otherwise the indices are merged in a single
+     * linear pass (after a stable sort of any index that isn't sorted) and the result is in label order; labels that
+     * are repeated on both sides produce every pairing, and values for labels missing from one side are NAN.
+     */
+    std::pair<Series, Series> Series::align(const Series &other, Join join) const {
+        POLARS_INSTRUMENT("Series::align");
+        if (is_aligned_with(other)) {
+            return {*this, Series(other.v, t)};
+        }
+
+        const arma::vec &lhs_index = index();
+        const arma::vec &rhs_index = other.index();
+        std::vector<arma::uword> lhs_order = _sorted_positions(t);
+        std::vector<arma::uword> rhs_order = _sorted_positions(other.t);
+
+        std::vector<double> labels;
+        std::vector<arma::uword> lhs_positions;
+        std::vector<arma::uword> rhs_positions;
+        if (join == Join::outer) {
+            labels.reserve(lhs_order.size() + rhs_order.size());
+            lhs_positions.reserve(lhs_order.size() + rhs_order.size());
+            rhs_positions.reserve(lhs_order.size() + rhs_order.size());
+        }
+
+        arma::uword i = 0;
+        arma::uword j = 0;
+        while (i < lhs_order.size() || j < rhs_order.size()) {
+            bool take_lhs = j == rhs_order.size() ||
+                            (i < lhs_order.size() && !(lhs_index[lhs_order[i]] == rhs_index[rhs_order[j]]) &&
+                             !_label_less(rhs_index[rhs_order[j]], lhs_index[lhs_order[i]]));
+            bool take_rhs = !take_lhs && (i == lhs_order.size() ||
+                                          !(lhs_index[lhs_order[i]] == rhs_index[rhs_order[j]]));
+
+            if (take_lhs) {
+                if (join == Join::outer) {
+                    labels.push_back(lhs_index[lhs_order[i]]);
+                    lhs_positions.push_back(lhs_order[i]);
+                    rhs_positions.push_back(missing_position);
+                }
+                i++;
+            } else if (take_rhs) {
+                if (join == Join::outer) {
+                    labels.push_back(rhs_index[rhs_order[j]]);
+                    lhs_positions.push_back(missing_position);
+                    rhs_positions.push_back(rhs_order[j]);
+                }
+                j++;
+            } else {
+                // Matching labels - pair up every occurrence on each side.
+                double label = lhs_index[lhs_order[i]];
+                arma::uword i_end = i;
+                while (i_end < lhs_order.size() && lhs_index[lhs_order[i_end]] == label) i_end++;
+                arma::uword j_end = j;
+                while (j_end < rhs_order.size() && rhs_index[rhs_order[j_end]] == label) j_end++;
+
+                for (arma::uword li = i; li < i_end; li++) {
+                    for (arma::uword rj = j; rj < j_end; rj++) {
+                        labels.push_back(label);
+                        lhs_positions.push_back(lhs_order[li]);
+                        rhs_positions.push_back(rhs_order[rj]);
+                    }
+                }
+                i = i_end;
+                j = j_end;
+            }
+        }
+
+        SharedIndex aligned_index(arma::conv_to<arma::vec>::from(labels));
+        return {Series(_take(v, lhs_positions), aligned_index), Series(_take(other.v, rhs_positions), aligned_index)};
+    }
+
 // Location.
 
     Series Series::iloc(int from, int to, int step) const {
+        POLARS_INSTRUMENT("Series::iloc");
 
         if(empty() || (from == to)){
             return Series();
@@ -204,60 +375,130 @@ namespace polars {
             pos = pos.subvec(0, size() - 1);
         }
 
-        return Series(values().elem(pos),index().elem(pos));
+        return Series(values().elem(pos), t.elem(pos));
     }
 
     // TODO: Add slicing logic of the form .iloc(int start, int stop, int step=1) so it can be called like ser.iloc(0, -10).
     Series Series::iloc(const arma::uvec &pos) const {
-        return Series(values().elem(pos), index().elem(pos));
+        POLARS_INSTRUMENT("Series::iloc");
+        return Series(values().elem(pos), t.elem(pos));
     }
 
 
     double Series::iloc(arma::uword pos) const {
-        arma::vec val = values().elem(arma::uvec{pos});
-        return val[0];
+        return v(pos);
     }
 
 // by label of indices
     Series Series::loc(const arma::vec &index_labels) const {
-
-        std::vector<int> indices;
-
-        for (int j = 0; j < index_labels.n_elem; j++) {
-
-            arma::uvec idx = arma::find(index() == index_labels[j]);
-
-            if (!idx.empty()) {
-                indices.push_back(idx[0]);
-            }
-        }
+        POLARS_INSTRUMENT("Series::loc");
+        arma::uvec indices = t.find_first(index_labels);
 
         if (indices.empty()) {
             return Series();
         } else {
-            arma::uvec indices_v = arma::conv_to<arma::uvec>::from(indices);
-            return Series(values().elem(indices_v), index().elem(indices_v));
+            return iloc(indices);
         }
     }
 
     Series Series::loc(arma::uword pos) const {
-        arma::uvec idx = arma::find(index() == pos);
+        arma::uvec idx = t.find_all(pos);
 
         if (!idx.empty()) {
-            return Series(values(), index()).iloc(idx);
+            return iloc(idx);
         } else {
             return Series();
         }
     }
 
+    namespace {
+
+        void _check_mask_size(const Series &series, const SeriesMask &condition) {
+            if (condition.size() != series.size()) {
+                throw std::logic_error("Series: mask size does not match the Series");
+            }
+        }
+
+    }  // namespace
+
+    /**
+     * Keep the values where condition is true and replace the others, like pandas.Series.where. The output is written
+     * in a single select pass over the values and the packed mask, with no intermediate positions.
+     */
     Series Series::where(const SeriesMask &condition, double other) const {
-        arma::vec result = values();
-        result.elem(find((!condition).values())).fill(other);
-        return Series(result, index());
+        POLARS_INSTRUMENT("Series::where");
+        _check_mask_size(*this, condition);
+        const BitMask &keep = condition.bits();
+
+        arma::vec result(size());
+        double *out = result.memptr();
+        const double *in = v.memptr();
+        for (arma::uword i = 0; i < result.n_elem; i++) {
+            out[i] = keep[i] ? in[i] : other;
+        }
+        return Series(std::move(result), t);
+    }
+
+    /**
+     * Replace the values where condition is true, the inverse of where(), like pandas.Series.mask.
+     */
+    Series Series::mask(const SeriesMask &condition, double other) const {
+        POLARS_INSTRUMENT("Series::mask");
+        _check_mask_size(*this, condition);
+        const BitMask &replace = condition.bits();
+
+        arma::vec result(size());
+        double *out = result.memptr();
+        const double *in = v.memptr();
+        for (arma::uword i = 0; i < result.n_elem; i++) {
+            out[i] = replace[i] ? other : in[i];
+        }
+        return Series(std::move(result), t);
+    }
+
+    /**
+     * Boolean indexing, series[mask]: the values and labels where condition is true. The output is sized from the
+     * popcount of the mask and filled in one pass over its set bits.
+     */
+    Series Series::operator[](const SeriesMask &condition) const {
+        POLARS_INSTRUMENT("Series::operator[]");
+        _check_mask_size(*this, condition);
+        const BitMask &keep = condition.bits();
+
+        arma::uword n = keep.count();
+        if (n == size()) {
+            return *this;
+        }
+
+        arma::vec values(n);
+        if (t.has_ticks()) {
+            double *out_values = values.memptr();
+            const double *in_values = v.memptr();
+            const std::int64_t *in_ticks = t.ticks();
+            std::vector<std::int64_t> ticks;
+            ticks.reserve(n);
+            keep.for_each_set([&](arma::uword i) {
+                *out_values++ = in_values[i];
+                ticks.push_back(in_ticks[i]);
+            });
+            return Series(std::move(values), SharedIndex::from_ticks(std::move(ticks)));
+        }
+
+        arma::vec labels(n);
+        double *out_values = values.memptr();
+        double *out_labels = labels.memptr();
+        const double *in_values = v.memptr();
+        const double *in_labels = t->memptr();
+        keep.for_each_set([&](arma::uword i) {
+            *out_values++ = in_values[i];
+            *out_labels++ = in_labels[i];
+        });
+        return Series(std::move(values), SharedIndex(std::move(labels)));
     }
 
 
     Series Series::diff() const {
+        POLARS_INSTRUMENT("Series::diff");
 
         arma::uword resultSize = values().size();
 
@@ -265,35 +506,39 @@ namespace polars {
 
         double previousValue = NAN;
         for (arma::uword idx = 0; idx < resultSize; idx++) {
-            resultv[idx] = values()[idx] - previousValue;
-            previousValue = values()[idx];
+            resultv[idx] = v[idx] - previousValue;
+            previousValue = v[idx];
         }
 
-        return Series(resultv, index());
+        return Series(resultv, t);
     }
 
 
     Series Series::abs() const {
-        return Series(arma::abs(values()), index());
+        POLARS_INSTRUMENT("Series::abs");
+        return Series(arma::abs(values()), t);
     }
 
     double Series::quantile(double q) const {
+        POLARS_INSTRUMENT("Series::quantile");
         return polars::numc::quantile(values(), q);
     }
 
     Series Series::fillna(double value) const {
+        POLARS_INSTRUMENT("Series::fillna");
         arma::vec vals = values();
         vals.replace(arma::datum::nan, value);
-        return Series(vals, index());
+        return Series(vals, t);
     }
 
     Series Series::dropna() const {
+        POLARS_INSTRUMENT("Series::dropna");
         // Get indices of finite elements
         arma::uvec indices = arma::sort(arma::join_cols(
                 arma::find_finite(values()),
                 arma::find(arma::abs(values()) == arma::datum::inf))
         );
-        return Series(values().elem(indices), index().elem(indices));
+        return Series(values().elem(indices), t.elem(indices));
     }
 
 
@@ -461,16 +706,90 @@ namespace polars {
     }
 
 
+    WindowBounds _window_bounds(arma::uword centerIdx, arma::uword inputSize, arma::uword windowSize,
+                                arma::uword centerOffset, bool symmetric) {
+
+        arma::sword leftIdx = centerIdx - centerOffset;
+        arma::sword rightIdx = centerIdx - centerOffset + windowSize - 1;
+        arma::sword weightLeftIdx = 0;
+        arma::sword weightRightIdx = windowSize - 1;
+
+        if (symmetric) {
+            // This option works for odd windows only.
+            if (leftIdx < 0) {
+                arma::sword left_err = leftIdx;
+                arma::sword right_err = windowSize - 1 - centerIdx - centerOffset;
+
+                weightLeftIdx = weightLeftIdx - left_err;
+                weightRightIdx = weightRightIdx - right_err;
+
+                rightIdx = rightIdx - right_err;
+                leftIdx = leftIdx - left_err;
+            }
+
+            if (rightIdx >= inputSize) {
+                arma::sword r_clipped = rightIdx - inputSize;
+
+                arma::sword left_err = -r_clipped - 1;
+                arma::sword right_err = rightIdx - (inputSize - 1);
+
+                weightLeftIdx = weightLeftIdx - left_err;
+                weightRightIdx = weightRightIdx - right_err;
+
+                leftIdx = leftIdx - left_err;
+                rightIdx = rightIdx - right_err;
+            }
+
+        } else {
+
+            if (leftIdx < 0) {
+                arma::sword left_err = leftIdx;
+
+                weightLeftIdx = weightLeftIdx - left_err;
+                leftIdx = leftIdx - left_err;
+            }
+
+            if (rightIdx >= inputSize) {
+                arma::sword right_err = rightIdx - (inputSize - 1);
+
+                weightRightIdx = weightRightIdx - right_err;
+                rightIdx = rightIdx - right_err;
+            }
+        }
+
+        return {leftIdx, rightIdx, weightLeftIdx, weightRightIdx};
+    }
+
+
+    // Rolling is done in blocks of output positions so that long series can be split across threads. Each block
+    // re-reads the window-sized halo before it, which is cheap as long as blocks are much larger than windows.
+    arma::uword _rolling_block_size(arma::uword windowSize) {
+        const arma::uword minBlockSize = 16384;
+        return std::max(minBlockSize, 16 * windowSize);
+    }
+
+
 // todo; allow passing in transformation function rather than WindowProcessor.
     Series
     Series::rolling(SeriesSize windowSize, const polars::WindowProcessor &processor, SeriesSize minPeriods,
-                    bool center, bool symmetric, polars::WindowProcessor::WindowType win_type, double alpha) const {
+                    bool center, bool symmetric, polars::WindowProcessor::WindowType win_type, double alpha,
+                    ThreadPool *pool) const {
+        POLARS_INSTRUMENT("Series::rolling");
 
         //assert(center); // todo; implement center:false
         //assert(windowSize > 0);
         //assert(windowSize % 2 == 0); // TODO: Make symmetric = true work for even windows. See tests for reference.
+        if (win_type == polars::WindowProcessor::WindowType::expn && dynamic_cast<const ExpMean *>(&processor) &&
+            !symmetric) {
+            // The exponential weights span the whole history whatever the window size, so use the O(n) recursion,
+            // which counts minPeriods in finite values as the windows below do. Those windows are the whole series, so
+            // minPeriods 0 means all of it. The padded emulation below never shifts expn windows for center, so only
+            // symmetric windows, which it treats its own way, are left to it.
+            return ewm(Decay::alpha(alpha), true, false, minPeriods == 0 ? size() : minPeriods).mean();
+        }
+
         arma::vec input_values = v;
-        arma::vec input_idx = t;
+        arma::vec input_idx = *t;
 
         if(win_type == polars::WindowProcessor::WindowType::expn){
             Series padded_input = _ewm_input_correction(*this);
@@ -496,71 +815,99 @@ namespace polars {
 
         arma::uword centerOffset = round(((float) windowSize - 1) / 2.0);
 
-        // roll a window [left,right], of up to size windowSize, centered on centerIdx, and hand to processor if there are minPeriods finite values.
-        for (arma::uword centerIdx = 0; centerIdx < input_idx.size(); centerIdx++) {
-
-            arma::sword leftIdx = centerIdx - centerOffset;
-            arma::sword rightIdx = centerIdx - centerOffset + windowSize - 1;
-            arma::sword weightLeftIdx = 0;
-            arma::sword weightRightIdx = windowSize - 1;
-
-            if (symmetric) {
-                // This option works for odd windows only.
-                if (leftIdx < 0) {
-                    arma::sword left_err = leftIdx;
-                    arma::sword right_err = windowSize - 1 - centerIdx - centerOffset;
-
-                    weightLeftIdx = weightLeftIdx - left_err;
-                    weightRightIdx = weightRightIdx - right_err;
-
-                    rightIdx = rightIdx - right_err;
-                    leftIdx = leftIdx - left_err;
+        // Unweighted windows can be updated incrementally if the processor supports it. The accumulator asked for to
+        // find out is kept and reused by serial blocks.
+        std::unique_ptr<WindowAccumulator> serialAccumulator =
+                win_type == polars::WindowProcessor::WindowType::none ? processor.accumulator() : nullptr;
+        bool incremental = serialAccumulator != nullptr;
+
+        // Every window uses a slice of the same weights, so only compute them (and any exp() calls) once.
+        const arma::vec windowWeights = incremental ? arma::vec() : calculate_window_weights(win_type, windowSize, alpha);
+
+        // Roll the windows centred on [first, last) into resultv, using accumulator when incremental. Each call starts
+        // from an empty accumulator, so the values only depend on the block boundaries, which are the same whether the
+        // blocks run serially or in parallel.
+        auto roll_block = [&](arma::uword first, arma::uword last, WindowAccumulator *accumulator) {
+            if (incremental) {
+                accumulator->reset();
+
+                // Window bounds only ever move forward, so each value is added and removed at most once: O(n) overall.
+                arma::sword windowLeftIdx = 0;
+                arma::sword windowRightIdx = -1;
+                arma::uword finiteCount = 0;
+
+                for (arma::uword centerIdx = first; centerIdx < last; centerIdx++) {
+                    WindowBounds bounds = _window_bounds(centerIdx, input_idx.size(), windowSize, centerOffset,
+                                                         symmetric);
+
+                    if (bounds.leftIdx < windowLeftIdx || bounds.rightIdx < windowRightIdx ||
+                        bounds.leftIdx > windowRightIdx + 1) {
+                        accumulator->reset();
+                        finiteCount = 0;
+                        windowLeftIdx = bounds.leftIdx;
+                        windowRightIdx = bounds.leftIdx - 1;
+                    }
+
+                    while (windowRightIdx < bounds.rightIdx) {
+                        windowRightIdx++;
+                        double value = input_values[windowRightIdx];
+                        if (std::isfinite(value)) {
+                            accumulator->add(value);
+                            finiteCount++;
+                        }
+                    }
+
+                    while (windowLeftIdx < bounds.leftIdx) {
+                        double value = input_values[windowLeftIdx];
+                        if (std::isfinite(value)) {
+                            accumulator->remove(value);
+                            finiteCount--;
+                        }
+                        windowLeftIdx++;
+                    }
+
+                    if (finiteCount >= minPeriods) {
+                        resultv(centerIdx) = accumulator->value();
+                    } else {
+                        resultv(centerIdx) = processor.defaultValue();
+                    }
                 }
-
-                if (rightIdx >= input_idx.size()) {
-                    arma::sword r_clipped = rightIdx - input_idx.size();
-
-                    arma::sword left_err = -r_clipped - 1;
-                    arma::sword right_err = rightIdx - (input_idx.size() - 1);
-
-                    weightLeftIdx = weightLeftIdx - left_err;
-                    weightRightIdx = weightRightIdx - right_err;
-
-                    leftIdx = leftIdx - left_err;
-                    rightIdx = rightIdx - right_err;
-                }
-
             } else {
+                // roll a window [left,right], of up to size windowSize, centered on centerIdx, and hand to processor if there are minPeriods finite values.
+                for (arma::uword centerIdx = first; centerIdx < last; centerIdx++) {
+                    WindowBounds bounds = _window_bounds(centerIdx, input_idx.size(), windowSize, centerOffset,
+                                                         symmetric);
 
-                if (leftIdx < 0) {
-                    arma::sword left_err = leftIdx;
+                    arma::vec values = input_values.subvec(bounds.leftIdx, bounds.rightIdx);
 
-                    weightLeftIdx = weightLeftIdx - left_err;
-                    leftIdx = leftIdx - left_err;
-                }
+                    // Slice of the weights lining up with this window, which may be clipped at either end.
+                    arma::vec weights = windowWeights.subvec(bounds.weightLeftIdx, bounds.weightRightIdx);
 
-                if (rightIdx >= input_idx.size()) {
-                    arma::sword right_err = rightIdx - (input_idx.size() - 1);
+                    const Series subSeries = Series(values, input_idx.subvec(bounds.leftIdx, bounds.rightIdx));
 
-                    weightRightIdx = weightRightIdx - right_err;
-                    rightIdx = rightIdx - right_err;
+                    if (subSeries.finiteSize() >= minPeriods) {
+                        resultv(centerIdx) = processor.processWindow(subSeries, weights);
+                    } else {
+                        resultv(centerIdx) = processor.defaultValue();
+                    }
                 }
             }
-
-            arma::vec values = input_values.subvec(leftIdx, rightIdx);
-
-            // Define weights vector required for specific windows
-            arma::vec weights;
-            weights.copy_size(values);
-            weights = polars::calculate_window_weights(win_type, windowSize, alpha).subvec(weightLeftIdx,
-                                                                                           weightRightIdx);
-
-            const Series subSeries = Series(values, input_idx.subvec(leftIdx, rightIdx));
-
-            if (subSeries.finiteSize() >= minPeriods) {
-                resultv(centerIdx) = processor.processWindow(subSeries, weights);
-            } else {
-                resultv(centerIdx) = processor.defaultValue();
+        };
+
+        arma::uword blockSize = _rolling_block_size(windowSize);
+        arma::uword blocks = (resultSize + blockSize - 1) / blockSize;
+        auto roll_nth_block = [&](arma::uword block, WindowAccumulator *accumulator) {
+            roll_block(block * blockSize, std::min(resultSize, (block + 1) * blockSize), accumulator);
+        };
+
+        if (pool && blocks > 1) {
+            pool->parallel_for(blocks, [&](arma::uword block) {
+                std::unique_ptr<WindowAccumulator> accumulator = incremental ? processor.accumulator() : nullptr;
+                roll_nth_block(block, accumulator.get());
+            });
+        } else {
+            for (arma::uword block = 0; block < blocks; block++) {
+                roll_nth_block(block, serialAccumulator.get());
             }
         }
 
@@ -591,15 +938,91 @@ namespace polars {
     };
 
 
+    /**
+     * Apply processor to windows that cover the index labels in (label - offset, label] for each value, so the number of
+     * values per window varies with the sampling rate.
+     *
+     * The index must be sorted. Both edges of the window then only move forward, so each window is found in amortised
+     * O(1) and, for processors with an accumulator, the whole computation is O(n).
+     */
+    Series Series::rolling_offset(double offset, const polars::WindowProcessor &processor,
+                                  SeriesSize minPeriods) const {
+        POLARS_INSTRUMENT("Series::rolling_offset");
+        if (!(offset > 0)) {
+            throw std::invalid_argument("Series::rolling_offset: offset must be positive");
+        }
+        if (!t.is_sorted()) {
+            throw std::invalid_argument("Series::rolling_offset: the index must be sorted");
+        }
+
+        const arma::vec &input_idx = *t;
+        arma::uword resultSize = size();
+        arma::vec resultv(resultSize);
+
+        std::unique_ptr<WindowAccumulator> accumulator = processor.accumulator();
+
+        arma::uword leftIdx = 0;
+        arma::uword finiteCount = 0;
+
+        for (arma::uword rightIdx = 0; rightIdx < resultSize; rightIdx++) {
+            double value = v[rightIdx];
+            if (std::isfinite(value)) {
+                if (accumulator) accumulator->add(value);
+                finiteCount++;
+            }
+
+            double windowStart = input_idx[rightIdx] - offset;
+            while (leftIdx <= rightIdx && input_idx[leftIdx] <= windowStart) {
+                double leaving = v[leftIdx];
+                if (std::isfinite(leaving)) {
+                    if (accumulator) accumulator->remove(leaving);
+                    finiteCount--;
+                }
+                leftIdx++;
+            }
+
+            // A window without finite values only gets this far when minPeriods is 0, and then only accumulators are
+            // asked for its value, such as 0 for Count, as processWindow expects at least one.
+            if (finiteCount < minPeriods || (finiteCount == 0 && !accumulator)) {
+                resultv(rightIdx) = processor.defaultValue();
+            } else if (accumulator) {
+                resultv(rightIdx) = accumulator->value();
+            } else {
+                arma::vec values = v.subvec(leftIdx, rightIdx);
+                const Series subSeries = Series(values, input_idx.subvec(leftIdx, rightIdx));
+                resultv(rightIdx) = processor.processWindow(subSeries, arma::ones<arma::vec>(values.n_elem));
+            }
+        }
+
+        return Series(std::move(resultv), t);
+    }
+
+    OffsetRolling Series::rolling_offset(double offset, SeriesSize minPeriods) const {
+        return OffsetRolling((*this), offset, minPeriods);
+    }
+
+
+    Resampler Series::resample(double width) const {
+        return Resampler((*this), width);
+    }
+
+
+    ExponentialWindow Series::ewm(Decay decay, bool adjust, bool ignoreNA, SeriesSize minPeriods) const {
+        return ExponentialWindow((*this), decay, adjust, ignoreNA, minPeriods);
+    }
+
+
     Series Series::clip(double lower_limit, double upper_limit) const {
-        SeriesMask upper = SeriesMask(values() < upper_limit, index());
-        SeriesMask lower = SeriesMask(values() > lower_limit, index());
-        return Series(values(), index()).where(upper, upper_limit).where(lower, lower_limit);
+        POLARS_INSTRUMENT("Series::clip");
+        SeriesMask upper = SeriesMask(v < upper_limit, t);
+        SeriesMask lower = SeriesMask(v > lower_limit, t);
+        return where(upper, upper_limit).where(lower, lower_limit);
     };
 
 
     Series Series::pow(double power) const {
-        return Series(arma::pow(values(), power), index());
+        POLARS_INSTRUMENT("Series::pow");
+        return Series(arma::pow(values(), power), t);
     }
 
 
@@ -609,44 +1032,45 @@ namespace polars {
 
 
     double Series::sum() const {
-        arma::vec finites = finiteValues();
-        if (finites.size() == 0) {
+        POLARS_INSTRUMENT("Series::sum");
+        polars::numc::FiniteSum finites = polars::numc::sum_count_finite(v);
+        if (finites.count == 0) {
             return NAN;
         } else {
-            return arma::sum(finites);
+            return finites.sum;
         }
     }
 
 
     double Series::mean() const {
-        arma::vec finites = finiteValues();
-        if (finites.size() == 0) {
+        POLARS_INSTRUMENT("Series::mean");
+        polars::numc::FiniteSum finites = polars::numc::sum_count_finite(v);
+        if (finites.count == 0) {
             return NAN;
         } else {
-            return arma::mean(finites);
+            return finites.sum / finites.count;
         }
     }
 
 
     double Series::std(int ddof) const {
-        arma::vec finites = finiteValues();
+        POLARS_INSTRUMENT("Series::std");
+        polars::numc::FiniteMoments finites = polars::numc::moments_finite(v);
         if (ddof < 0) {
             ddof = 0;
         }
-        auto n = finites.size();
+        auto n = finites.count;
         if (n <= ddof) {
             return NAN;
         } else {
-            auto dev = (*this) - this->mean();
-            auto squared_deviation = dev.pow(2);
-            return std::pow(squared_deviation.sum() / (n - ddof), 0.5);
+            return std::sqrt(finites.m2 / (n - ddof));
         }
     }
 
 
     Series::SeriesSize Series::size() const {
         //assert(index().size() == values().size());
-        return index().size();
+        return t.size();
     }
 
 
@@ -657,22 +1081,25 @@ namespace polars {
 
     Series::SeriesSize Series::finiteSize() const {
         //assert(index().size() == values().size());
-        return finiteValues().size();
+        return polars::numc::count_finite(v);
     }
 
 
-// done this way so default copy / assignment works.
-// todo; make copies of indices share memory as they are const?
-    const arma::vec Series::index() const {
-        return t;
+    const arma::vec &Series::index() const {
+        return *t;
     }
 
 
-    const arma::vec Series::values() const {
+    const arma::vec &Series::values() const {
         return v;
     }
 
 
+    const SharedIndex &Series::shared_index() const {
+        return t;
+    }
+
+
     bool Series::equal(const Series &lhs, const Series &rhs) {
         return lhs.equals(rhs);
     }
@@ -688,21 +1115,23 @@ namespace polars {
     }
 
     Series Series::apply(double (*f)(double)) const {
+        POLARS_INSTRUMENT("Series::apply");
         arma::vec vals = values();
         vals.transform([=](double val) { return (f(val)); });
-        return Series(vals, index());
+        return Series(vals, t);
     }
 
     Series Series::index_as_series() const {
-        return Series(index(), index());
+        return Series(*t, t);
     }
 
     std::map<double, double> Series::to_map() const {
+        POLARS_INSTRUMENT("Series::to_map");
 
         std::map<double, double> m;
         // put pairs into map
         for (int i = 0; i < size(); i++) {
-            m.insert(std::make_pair(index()[i], values()[i]));
+            m.insert(std::make_pair((*t)[i], v[i]));
         }
 
         return m;
@@ -714,26 +1143,24 @@ namespace polars {
 
     // TODO: Modify head once iloc has been refactored to accept slicing logic.
     Series Series::head(int n) const  {
-        Series ser(values(), index());
-        if(n >= ser.size()){
-            return ser;
+        POLARS_INSTRUMENT("Series::head");
+        if(n >= size()){
+            return *this;
         } else {
             arma::uvec indices = arma::conv_to<arma::uvec>::from(polars::numc::arange(0, n));
-            return ser.iloc(indices);
+            return iloc(indices);
         }
     }
 
     // TODO: Modify tail once iloc has been refactored to accept slicing logic.
     Series Series::tail(int n) const  {
-
-        Series ser(values(), index());
-
-        if(n >= ser.size()){
-            return ser;
+        POLARS_INSTRUMENT("Series::tail");
+        if(n >= size()){
+            return *this;
         } else {
-            arma::uword l = ser.size() - n;
-            arma::uvec indices = arma::conv_to<arma::uvec>::from(polars::numc::arange(l, ser.size()));
-            return ser.iloc(indices);
+            arma::uword l = size() - n;
+            arma::uvec indices = arma::conv_to<arma::uvec>::from(polars::numc::arange(l, size()));
+            return iloc(indices);
         }
     }
 
@@ -5,6 +5,9 @@
 #ifndef ZIMMER_SERIES_H
 #define ZIMMER_SERIES_H
 
+#include "ExponentialWindow.h"
+#include "Resampler.h"
+#include "SharedIndex.h"
 #include "WindowProcessor.h"
 
 #include "armadillo"
@@ -13,20 +16,33 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <utility>
 
 
 namespace polars {
     class SeriesMask;
+    class ThreadPool;
 
 
     class Series {
     public:
         typedef arma::uword SeriesSize;
 
+        /**
+         * How two indices are combined when aligning Series - as in pandas, outer keeps the union of the labels and
+         * inner only the labels found in both.
+         */
+        enum class Join {
+            outer,
+            inner
+        };
+
         Series();
 
         Series(const arma::vec &v, const arma::vec &t);
 
+        Series(arma::vec v, const SharedIndex &t);
+
         Series(const SeriesMask &sm);
 
         static Series from_vect(const std::vector<double> &t_v, const std::vector<double> &v_v);
@@ -67,6 +83,10 @@ namespace polars {
 
         bool almost_equals(const Series &rhs) const;
 
+        bool is_aligned_with(const Series &rhs) const;
+
+        std::pair<Series, Series> align(const Series &other, Join join = Join::outer) const;
+
         Series iloc(const arma::uvec &pos) const;
 
         double iloc(arma::uword pos) const;
@@ -79,6 +99,10 @@ namespace polars {
 
         Series where(const SeriesMask &condition, double other = NAN) const;
 
+        Series mask(const SeriesMask &condition, double other = NAN) const;
+
+        Series operator[](const SeriesMask &condition) const;
+
         Series diff() const;
 
         Series abs() const;
@@ -93,13 +117,18 @@ namespace polars {
 
         Series pow(double power) const;
 
+        /**
+         * Apply processor to each window of windowSize values. Passing a pool splits long series into blocks that are
+         * rolled concurrently; the result is bit-for-bit the same as without one.
+         */
         Series rolling(SeriesSize windowSize,
                        const WindowProcessor &processor,
                        SeriesSize minPeriods = 0, /* 0 treated as windowSize */
                        bool center = true,
                        bool symmetric = false,
                        WindowProcessor::WindowType win_type = WindowProcessor::WindowType::none,
-                       double alpha = -1) const;
+                       double alpha = -1,
+                       ThreadPool *pool = nullptr) const;
 
         Window rolling(SeriesSize windowSize,
                        SeriesSize minPeriods, /* 0 treated as windowSize */
@@ -113,6 +142,17 @@ namespace polars {
                         bool center = true,
                         bool symmetric = false) const;
 
+        Series rolling_offset(double offset,
+                              const WindowProcessor &processor,
+                              SeriesSize minPeriods = 1) const;
+
+        OffsetRolling rolling_offset(double offset, SeriesSize minPeriods = 1) const;
+
+        Resampler resample(double width) const;
+
+        ExponentialWindow ewm(Decay decay, bool adjust = true, bool ignoreNA = false,
+                              SeriesSize minPeriods = 0) const;
+
         Series apply(double (*f)(double)) const;
 
         int count() const;
@@ -129,11 +169,12 @@ namespace polars {
 
         SeriesSize finiteSize() const;
 
-        // done this way so default copy / assignment works.
-        // todo; make copies of indices share memory as they are const?
-        const arma::vec index() const;
+        // read-only references to the underlying data so that callers do not pay for a copy.
+        const arma::vec &index() const;
+
+        const arma::vec &values() const;
 
-        const arma::vec values() const;
+        const SharedIndex &shared_index() const;
 
         static bool equal(const Series &lhs, const Series &rhs);
 
@@ -152,7 +193,8 @@ namespace polars {
         Series tail(int n=5) const;
 
     protected:
-        arma::vec t;
+        // the index is shared by every Series / SeriesMask derived from this one.
+        SharedIndex t;
         arma::vec v;
     };
 
@@ -0,0 +1,356 @@
+#ifndef POLARS_SERIESEXPRESSION_H
+#define POLARS_SERIESEXPRESSION_H
+
+#include "Series.h"
+#include "SeriesMask.h"
+#include "SharedIndex.h"
+
+#include "armadillo"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+
+/**
+ * Lazy evaluation of chained element-wise Series operations.
+ *
+ * Wrapping a Series in polars::lazy() makes the usual operators build an expression rather than a new Series, e.g.
+ *
+ *     Series result = (lazy(a) - b) * 2.0 + c;
+ *     SeriesMask mask = (lazy(a) - b).abs() > 0.5;
+ *
+ * The whole chain is evaluated in a single pass with one output allocation, either when it is assigned to a Series /
+ * SeriesMask or on an explicit .eval(), and the result shares its index with the operands. As with Armadillo
+ * expressions the operands are held by reference, so evaluate an expression before the Series it uses go out of scope.
+ * Operands must have identical indices; use Series::align first if they don't.
+ */
+namespace polars {
+
+    namespace expression {
+
+        // A Series operand.
+        class Leaf {
+        public:
+            explicit Leaf(const Series &series) : values(series.values().memptr()), n(series.size()),
+                                                  index(&series.shared_index()) {}
+
+            inline double operator[](arma::uword i) const {
+                return values[i];
+            }
+
+            inline arma::uword size() const {
+                return n;
+            }
+
+            inline const SharedIndex *shared_index() const {
+                return index;
+            }
+
+        private:
+            const double *values;
+            arma::uword n;
+            const SharedIndex *index;
+        };
+
+        // A scalar operand, which has no size or index of its own.
+        class Scalar {
+        public:
+            explicit Scalar(double value) : value(value) {}
+
+            inline double operator[](arma::uword) const {
+                return value;
+            }
+
+            inline arma::uword size() const {
+                return 0;
+            }
+
+            inline const SharedIndex *shared_index() const {
+                return nullptr;
+            }
+
+        private:
+            double value;
+        };
+
+        // Lazy expressions don't reindex, so unlike the eager operators they need operands with identical indices.
+        inline bool aligned(const SharedIndex &lhs, const SharedIndex &rhs) {
+            if (lhs.shares_memory_with(rhs)) return true;
+            if (lhs->n_elem != rhs->n_elem) return false;
+            return !arma::any(*lhs != *rhs);
+        }
+
+        template<class L, class R, class Op>
+        class Binary {
+        public:
+            Binary(const L &lhs, const R &rhs, Op op = Op()) : lhs(lhs), rhs(rhs), op(op) {
+                if (lhs.shared_index() && rhs.shared_index() && !aligned(*lhs.shared_index(), *rhs.shared_index())) {
+                    throw std::logic_error("polars::expression: Series indices differ, align them first");
+                }
+            }
+
+            inline auto operator[](arma::uword i) const -> decltype(std::declval<Op>()(0., 0.)) {
+                return op(lhs[i], rhs[i]);
+            }
+
+            inline arma::uword size() const {
+                return lhs.shared_index() ? lhs.size() : rhs.size();
+            }
+
+            inline const SharedIndex *shared_index() const {
+                return lhs.shared_index() ? lhs.shared_index() : rhs.shared_index();
+            }
+
+        private:
+            L lhs;
+            R rhs;
+            Op op;
+        };
+
+        template<class E, class Op>
+        class Unary {
+        public:
+            Unary(const E &e, Op op) : e(e), op(op) {}
+
+            inline auto operator[](arma::uword i) const -> decltype(std::declval<Op>()(0.)) {
+                return op(e[i]);
+            }
+
+            inline arma::uword size() const {
+                return e.size();
+            }
+
+            inline const SharedIndex *shared_index() const {
+                return e.shared_index();
+            }
+
+        private:
+            E e;
+            Op op;
+        };
+
+        struct Plus {
+            inline double operator()(double a, double b) const { return a + b; }
+        };
+
+        struct Minus {
+            inline double operator()(double a, double b) const { return a - b; }
+        };
+
+        struct Multiply {
+            inline double operator()(double a, double b) const { return a * b; }
+        };
+
+        struct Greater {
+            inline bool operator()(double a, double b) const { return a > b; }
+        };
+
+        struct GreaterEqual {
+            inline bool operator()(double a, double b) const { return a >= b; }
+        };
+
+        struct Less {
+            inline bool operator()(double a, double b) const { return a < b; }
+        };
+
+        struct LessEqual {
+            inline bool operator()(double a, double b) const { return a <= b; }
+        };
+
+        struct Equal {
+            inline bool operator()(double a, double b) const { return a == b; }
+        };
+
+        struct NotEqual {
+            inline bool operator()(double a, double b) const { return a != b; }
+        };
+
+        struct And {
+            inline bool operator()(double a, double b) const { return a && b; }
+        };
+
+        struct Or {
+            inline bool operator()(double a, double b) const { return a || b; }
+        };
+
+        struct Not {
+            inline bool operator()(double a) const { return !a; }
+        };
+
+        struct Abs {
+            inline double operator()(double a) const { return std::abs(a); }
+        };
+
+        struct Pow {
+            double power;
+
+            inline double operator()(double a) const { return std::pow(a, power); }
+        };
+
+        // Same comparisons as Series::clip, which also means NANs are clipped to the lower limit.
+        struct Clip {
+            double lower_limit;
+            double upper_limit;
+
+            inline double operator()(double a) const {
+                double upper_clipped = a < upper_limit ? a : upper_limit;
+                return a > lower_limit ? upper_clipped : lower_limit;
+            }
+        };
+
+        template<class E>
+        const SharedIndex &result_index(const E &e) {
+            if (!e.shared_index()) {
+                throw std::logic_error("polars::expression: expression does not involve a Series");
+            }
+            return *e.shared_index();
+        }
+
+    }  // expression
+
+
+    template<class E>
+    class SeriesExpression {
+    public:
+        explicit SeriesExpression(const E &e) : e(e) {}
+
+        Series eval() const {
+            arma::uword n = e.size();
+            arma::vec result(n);
+            double *out = result.memptr();
+            for (arma::uword i = 0; i < n; i++) {
+                out[i] = e[i];
+            }
+            return Series(std::move(result), expression::result_index(e));
+        }
+
+        operator Series() const {
+            return eval();
+        }
+
+        SeriesExpression<expression::Unary<E, expression::Abs>> abs() const {
+            return SeriesExpression<expression::Unary<E, expression::Abs>>({e, expression::Abs()});
+        }
+
+        SeriesExpression<expression::Unary<E, expression::Pow>> pow(double power) const {
+            return SeriesExpression<expression::Unary<E, expression::Pow>>({e, expression::Pow{power}});
+        }
+
+        SeriesExpression<expression::Unary<E, expression::Clip>> clip(double lower_limit, double upper_limit) const {
+            return SeriesExpression<expression::Unary<E, expression::Clip>>(
+                    {e, expression::Clip{lower_limit, upper_limit}});
+        }
+
+        const E &node() const {
+            return e;
+        }
+
+    private:
+        E e;
+    };
+
+
+    template<class E>
+    class SeriesMaskExpression {
+    public:
+        explicit SeriesMaskExpression(const E &e) : e(e) {}
+
+        SeriesMask eval() const {
+            arma::uword n = e.size();
+            BitMask result(n);
+            for (arma::uword i = 0; i < n; i++) {
+                if (e[i]) result.set(i);
+            }
+            return SeriesMask(std::move(result), expression::result_index(e));
+        }
+
+        operator SeriesMask() const {
+            return eval();
+        }
+
+        const E &node() const {
+            return e;
+        }
+
+    private:
+        E e;
+    };
+
+
+    inline SeriesExpression<expression::Leaf> lazy(const Series &series) {
+        return SeriesExpression<expression::Leaf>(expression::Leaf(series));
+    }
+
+
+// Defines `op` between expressions, Series and doubles, producing a Wrapper<expression::Binary<..., Op>>.
+#define POLARS_EXPRESSION_OPERATOR(op, Op, Wrapper)                                                                   \
+    template<class L, class R>                                                                                         \
+    Wrapper<expression::Binary<L, R, expression::Op>>                                                                  \
+    operator op(const SeriesExpression<L> &lhs, const SeriesExpression<R> &rhs) {                                      \
+        return Wrapper<expression::Binary<L, R, expression::Op>>({lhs.node(), rhs.node()});                            \
+    }                                                                                                                  \
+                                                                                                                       \
+    template<class L>                                                                                                  \
+    Wrapper<expression::Binary<L, expression::Leaf, expression::Op>>                                                   \
+    operator op(const SeriesExpression<L> &lhs, const Series &rhs) {                                                   \
+        return Wrapper<expression::Binary<L, expression::Leaf, expression::Op>>(                                       \
+                {lhs.node(), expression::Leaf(rhs)});                                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    template<class R>                                                                                                  \
+    Wrapper<expression::Binary<expression::Leaf, R, expression::Op>>                                                   \
+    operator op(const Series &lhs, const SeriesExpression<R> &rhs) {                                                   \
+        return Wrapper<expression::Binary<expression::Leaf, R, expression::Op>>(                                       \
+                {expression::Leaf(lhs), rhs.node()});                                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    template<class L>                                                                                                  \
+    Wrapper<expression::Binary<L, expression::Scalar, expression::Op>>                                                 \
+    operator op(const SeriesExpression<L> &lhs, double rhs) {                                                          \
+        return Wrapper<expression::Binary<L, expression::Scalar, expression::Op>>(                                     \
+                {lhs.node(), expression::Scalar(rhs)});                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    template<class R>                                                                                                  \
+    Wrapper<expression::Binary<expression::Scalar, R, expression::Op>>                                                 \
+    operator op(double lhs, const SeriesExpression<R> &rhs) {                                                          \
+        return Wrapper<expression::Binary<expression::Scalar, R, expression::Op>>(                                     \
+                {expression::Scalar(lhs), rhs.node()});                                                                \
+    }
+
+    POLARS_EXPRESSION_OPERATOR(+, Plus, SeriesExpression)
+    POLARS_EXPRESSION_OPERATOR(-, Minus, SeriesExpression)
+    POLARS_EXPRESSION_OPERATOR(*, Multiply, SeriesExpression)
+
+    POLARS_EXPRESSION_OPERATOR(>, Greater, SeriesMaskExpression)
+    POLARS_EXPRESSION_OPERATOR(>=, GreaterEqual, SeriesMaskExpression)
+    POLARS_EXPRESSION_OPERATOR(<, Less, SeriesMaskExpression)
+    POLARS_EXPRESSION_OPERATOR(<=, LessEqual, SeriesMaskExpression)
+    POLARS_EXPRESSION_OPERATOR(==, Equal, SeriesMaskExpression)
+    POLARS_EXPRESSION_OPERATOR(!=, NotEqual, SeriesMaskExpression)
+
+#undef POLARS_EXPRESSION_OPERATOR
+
+
+    template<class L, class R>
+    SeriesMaskExpression<expression::Binary<L, R, expression::And>>
+    operator&(const SeriesMaskExpression<L> &lhs, const SeriesMaskExpression<R> &rhs) {
+        return SeriesMaskExpression<expression::Binary<L, R, expression::And>>({lhs.node(), rhs.node()});
+    }
+
+    template<class L, class R>
+    SeriesMaskExpression<expression::Binary<L, R, expression::Or>>
+    operator|(const SeriesMaskExpression<L> &lhs, const SeriesMaskExpression<R> &rhs) {
+        return SeriesMaskExpression<expression::Binary<L, R, expression::Or>>({lhs.node(), rhs.node()});
+    }
+
+    template<class E>
+    SeriesMaskExpression<expression::Unary<E, expression::Not>> operator!(const SeriesMaskExpression<E> &e) {
+        return SeriesMaskExpression<expression::Unary<E, expression::Not>>({e.node(), expression::Not()});
+    }
+
+}  // polars
+
+
+#endif //POLARS_SERIESEXPRESSION_H
@@ -4,6 +4,7 @@
 
 #include "SeriesMask.h"
 
+#include "Instrumentation.h"
 #include "Series.h"
 #include "numc.h"
 
@@ -12,16 +13,38 @@
 
 namespace polars {
 
-    SeriesMask::SeriesMask() = default;
+    SeriesMask::SeriesMask() : t(arma::vec()) {}
 
 
     SeriesMask::SeriesMask(const arma::uvec &v, const arma::vec &t) : t(t), v(v) {
         //assert(t.n_cols == 1 && v.n_cols == 1);
         //assert(t.n_rows == v.n_rows);
-        //assert(!arma::any(v > 1));  // Np SeriesMask values may be greater than 1
+        // values greater than 1 are stored as a true flag, as the bits hold nothing more.
     };
 
+    /**
+     * Construct a SeriesMask that shares its index with existing Series / SeriesMasks rather than copying it.
+     */
+    SeriesMask::SeriesMask(const arma::uvec &v, const SharedIndex &t) : t(t), v(v) {}
+
+
+    SeriesMask::SeriesMask(BitMask v, const SharedIndex &t) : t(t), v(std::move(v)) {}
+
+
+    // Copies leave the unpacked values behind: at 8 bytes a flag they cost 64 times the bits, so only the mask that
+    // asked for them keeps them.
+    SeriesMask::SeriesMask(const SeriesMask &other) : t(other.t), v(other.v) {}
+
+
+    SeriesMask &SeriesMask::operator=(const SeriesMask &other) {
+        t = other.t;
+        v = other.v;
+        unpacked.reset();
+        return *this;
+    }
+
     SeriesMask SeriesMask::iloc(int from, int to, int step) const {
+        POLARS_INSTRUMENT("SeriesMask::iloc");
 
         if(empty()  || (from == to)){
             return SeriesMask();
@@ -32,13 +55,13 @@ namespace polars {
         int effective_to;
 
         if(from < 0){
-            effective_from = values().size() + from;
+            effective_from = size() + from;
         } else {
             effective_from = from;
         }
 
         if(to < 0){
-            effective_to = values().size() + to - 1;
+            effective_to = size() + to - 1;
         } else if(to == 0) {
             effective_to = to;
         } else {
@@ -51,47 +74,37 @@ namespace polars {
             pos = pos.subvec(0, size() - 1);
         }
 
-        return SeriesMask(values().elem(pos),index().elem(pos));
+        return SeriesMask(v.elem(pos), t.elem(pos));
     }
 
 // TODO: Add slicing logic of the form .iloc(int start, int stop, int step=1) so it can be called like ser.iloc(0, -10).
     SeriesMask SeriesMask::iloc(const arma::uvec &pos) const {
-        return SeriesMask(values().elem(pos), index().elem(pos));
+        POLARS_INSTRUMENT("SeriesMask::iloc");
+        return SeriesMask(v.elem(pos), t.elem(pos));
     }
 
 
     double SeriesMask::iloc(arma::uword pos) const {
-        arma::uvec val = values().elem(arma::uvec{pos});
-        return val[0];
+        return v[pos];
     }
 
     // by label of indices
     SeriesMask SeriesMask::loc(const arma::vec &index_labels) const {
-
-        std::vector<int> indices;
-
-        for (int j = 0; j < index_labels.n_elem; j++) {
-
-            arma::uvec idx = arma::find(index() == index_labels[j]);
-
-            if (!idx.empty()) {
-                indices.push_back(idx[0]);
-            }
-        }
+        POLARS_INSTRUMENT("SeriesMask::loc");
+        arma::uvec indices = t.find_first(index_labels);
 
         if (indices.empty()) {
             return SeriesMask();
         } else {
-            arma::uvec indices_v = arma::conv_to<arma::uvec>::from(indices);
-            return SeriesMask(values().elem(indices_v), index().elem(indices_v));
+            return iloc(indices);
         }
     }
 
     SeriesMask SeriesMask::loc(arma::uword pos) const {
-        arma::uvec idx = arma::find(index() == pos);
+        arma::uvec idx = t.find_all(pos);
 
         if (!idx.empty()) {
-            return SeriesMask(values(), index()).iloc(idx);
+            return iloc(idx);
         } else {
             return SeriesMask();
         }
@@ -99,63 +112,70 @@ namespace polars {
 
     // Series [op] int methods
     SeriesMask SeriesMask::operator==(const bool rhs) const {
-        arma::ivec rhs_vec = arma::ones<arma::ivec>(this->size()) * (int)rhs;
-        arma::ivec abs_diff = arma::abs(values() - rhs_vec);
-        return {abs_diff == 0, index()};
+        POLARS_INSTRUMENT("SeriesMask::operator==");
+        return {rhs ? v : ~v, t};
     }
 
 
     SeriesMask SeriesMask::operator!=(const bool rhs) const {  // TODO implement as negation of operator==
-        arma::ivec rhs_vec = arma::ones<arma::ivec>(this->size()) * (int)rhs;
-        arma::ivec abs_diff = arma::abs(values() - rhs_vec);
-        return {abs_diff != 0, index()};
+        POLARS_INSTRUMENT("SeriesMask::operator!=");
+        return {rhs ? ~v : v, t};
     }
 
 
     // Series [op] Series methods
     SeriesMask SeriesMask::operator==(const SeriesMask &rhs) const {
+        POLARS_INSTRUMENT("SeriesMask::operator==");
         // TODO: make this fast enough to always check at runtime
         //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask(values() == rhs.values(), index());
+        return SeriesMask(~(v ^ rhs.v), t);
     }
 
 
     SeriesMask SeriesMask::operator!=(const SeriesMask &rhs) const {
+        POLARS_INSTRUMENT("SeriesMask::operator!=");
         // TODO: make this fast enough to always check at runtime
         //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask(values() != rhs.values(), index());
+        return SeriesMask(v ^ rhs.v, t);
     }
 
     SeriesMask SeriesMask::operator|(const SeriesMask &rhs) const {
+        POLARS_INSTRUMENT("SeriesMask::operator|");
         //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask((values() + rhs.values()) > 0, index());
+        return SeriesMask(v | rhs.v, t);
     }
 
 
     SeriesMask SeriesMask::operator&(const SeriesMask &rhs) const {
+        POLARS_INSTRUMENT("SeriesMask::operator&");
         //assert(!arma::any(index() != rhs.index()));  // Use not any != to handle empty array case
-        return SeriesMask((values() + rhs.values()) == 2, index());
+        return SeriesMask(v & rhs.v, t);
     }
 
 
     SeriesMask SeriesMask::operator!() const {
-        return SeriesMask(values() == 0, index());
+        POLARS_INSTRUMENT("SeriesMask::operator!");
+        return SeriesMask(~v, t);
     }
 
 
     bool SeriesMask::equals(const SeriesMask &rhs) const {
-        if ((values().n_rows != rhs.values().n_rows)) return false;
         if ((index().n_rows != rhs.index().n_rows)) return false;
 
-        if (any(values() != rhs.values())) return false;
+        if (v != rhs.v) return false;
 
-        if (any(index() != rhs.index())) return false;
+        if (!t.shares_memory_with(rhs.t) && any(index() != rhs.index())) return false;
         return true;
     }
 
     SeriesMask::SeriesSize SeriesMask::size() const {
         //assert(index().size() == values().size());
-        return index().size();
+        return t.size();
+    }
+
+
+    SeriesMask::SeriesSize SeriesMask::count() const {
+        return v.count();
     }
 
 
@@ -182,33 +202,49 @@ namespace polars {
      * @return the ostream for further piping
      */
     std::ostream &operator<<(std::ostream &os, const SeriesMask &ts) {
-        return os << "SeriesMask:\nindices\n" << ts.index() << "values\n" << ts.values();
+        return os << "SeriesMask:\nindices\n" << ts.index() << "values\n" << ts.bits().to_uvec();
+    }
+
+
+    const arma::vec &SeriesMask::index() const { return *t; }
+
+
+    const arma::uvec &SeriesMask::values() const {
+        std::shared_ptr<const arma::uvec> current = std::atomic_load(&unpacked);
+        if (!current) {
+            // Threads racing here each unpack the bits, but only the first to finish keeps its copy.
+            std::shared_ptr<const arma::uvec> fresh = std::make_shared<const arma::uvec>(v.to_uvec());
+            current = std::atomic_compare_exchange_strong(&unpacked, &current, fresh) ? fresh : current;
+        }
+        return *current;
     }
 
 
-    const arma::vec SeriesMask::index() const { return t; }
+    const BitMask &SeriesMask::bits() const { return v; }
 
 
-    const arma::uvec SeriesMask::values() const { return v; }
+    const SharedIndex &SeriesMask::shared_index() const { return t; }
 
 
     std::map<double, bool> SeriesMask::to_map() const {
+        POLARS_INSTRUMENT("SeriesMask::to_map");
 
         std::map<double, bool> m;
         // put pairs into map
         for (int i = 0; i < size(); i++) {
-            m.insert(std::make_pair(index()[i], values()[i]));
+            m.insert(std::make_pair((*t)[i], v[i]));
         }
 
         return m;
     }
 
     bool SeriesMask::empty() const {
-        return (index().is_empty() & values().is_empty());
+        return (index().is_empty() & (v.size() == 0));
     }
 
     // TODO: Modify head once iloc has been refactored to accept slicing logic.
     SeriesMask SeriesMask::head(int n) const  {
+        POLARS_INSTRUMENT("SeriesMask::head");
         if(n >= size()){
             return *this;
         } else {
@@ -219,6 +255,7 @@ namespace polars {
 
     // TODO: Modify tail once iloc has been refactored to accept slicing logic.
     SeriesMask SeriesMask::tail(int n) const  {
+        POLARS_INSTRUMENT("SeriesMask::tail");
         if(n >= size()){
             return *this;
         } else {
@@ -5,8 +5,13 @@
 #ifndef ZIMMER_SERIESMASK_H
 #define ZIMMER_SERIESMASK_H
 
+#include "BitMask.h"
+#include "SharedIndex.h"
+
 #include "armadillo"
 
+#include <memory>
+
 
 namespace polars {
 
@@ -21,8 +26,21 @@ namespace polars {
         typedef arma::uword SeriesSize;
         SeriesMask();
 
+        // Any non-zero value is a true flag, which values() gives back as 1.
         SeriesMask(const arma::uvec &v, const arma::vec &t);
 
+        SeriesMask(const arma::uvec &v, const SharedIndex &t);
+
+        SeriesMask(BitMask v, const SharedIndex &t);
+
+        SeriesMask(const SeriesMask &other);
+
+        SeriesMask(SeriesMask &&other) = default;
+
+        SeriesMask &operator=(const SeriesMask &other);
+
+        SeriesMask &operator=(SeriesMask &&other) = default;
+
         SeriesMask iloc(const arma::uvec &pos) const;
 
         double iloc(arma::uword pos) const;
@@ -47,12 +65,21 @@ namespace polars {
 
         SeriesSize size() const;
 
+        // number of true values.
+        SeriesSize count() const;
+
         static bool equal(const SeriesMask &lhs, const SeriesMask &rhs);
 
-        // done this way so default copy / assignment works.
-        // todo; make copies of series share memory as they are const?
-        const arma::vec index() const;
-        const arma::uvec values() const;
+        // read-only reference to the index so that callers do not pay for a copy.
+        const arma::vec &index() const;
+
+        // the values are stored bit-packed, so this unpacks them on first use and keeps them for later calls on this
+        // mask, though not its copies. That costs 8 bytes a flag; use bits() to work with the packed flags directly.
+        const arma::uvec &values() const;
+
+        const BitMask &bits() const;
+
+        const SharedIndex &shared_index() const;
 
         std::map<double, bool> to_map() const;
 
@@ -63,8 +90,15 @@ namespace polars {
         SeriesMask tail(int n=5) const;
 
     private:
-        arma::vec t;
-        arma::uvec v;
+        friend class Series;
+
+        // the index is shared by every Series / SeriesMask derived from this one.
+        SharedIndex t;
+        BitMask v;
+
+        // values() unpacked, once asked for, and not copied with the mask. Only ever read and set atomically, as const
+        // methods may race to set it.
+        mutable std::shared_ptr<const arma::uvec> unpacked;
     };
 
 
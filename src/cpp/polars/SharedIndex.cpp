@@ -0,0 +1,180 @@
+#include "SharedIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+
+namespace polars {
+
+    namespace {
+
+        bool _is_sorted(const arma::vec &index) {
+            if (!index.empty() && std::isnan(index[0])) {
+                return false;
+            }
+            for (arma::uword i = 1; i < index.n_elem; i++) {
+                // Also false for NANs, which a binary search can't cope with.
+                if (!(index[i - 1] <= index[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }  // namespace
+
+
+    SharedIndex::SharedIndex(const arma::vec &index) : data(std::make_shared<const arma::vec>(index)),
+                                                       sorted(_is_sorted(*data)) {}
+
+
+    SharedIndex::SharedIndex(arma::vec &&index) : data(std::make_shared<const arma::vec>(std::move(index))),
+                                                  sorted(_is_sorted(*data)) {}
+
+
+    SharedIndex::SharedIndex(Adopted, std::shared_ptr<const arma::vec> index, bool sorted) : data(std::move(index)),
+                                                                                             sorted(sorted) {}
+
+
+    SharedIndex SharedIndex::adopt(std::shared_ptr<const arma::vec> index, bool sorted) {
+        return SharedIndex(Adopted(), std::move(index), sorted);
+    }
+
+
+    SharedIndex SharedIndex::adopt(std::shared_ptr<const arma::vec> index) {
+        bool sorted = _is_sorted(*index);
+        return SharedIndex(Adopted(), std::move(index), sorted);
+    }
+
+
+    SharedIndex::SharedIndex(Adopted, std::shared_ptr<const Ticks> ticks, bool sorted)
+            : exactTicks(std::move(ticks)), sorted(sorted) {}
+
+
+    SharedIndex SharedIndex::from_ticks(std::vector<std::int64_t> ticks) {
+        auto owner = std::make_shared<const std::vector<std::int64_t>>(std::move(ticks));
+        std::shared_ptr<const std::int64_t> values(owner, owner->data());
+        bool sorted = std::is_sorted(owner->begin(), owner->end());
+        return adopt_ticks(std::move(values), owner->size(), sorted);
+    }
+
+
+    SharedIndex SharedIndex::adopt_ticks(std::shared_ptr<const std::int64_t> ticks, arma::uword n, bool sorted) {
+        return SharedIndex(Adopted(), std::make_shared<const Ticks>(Ticks{std::move(ticks), n, nullptr}), sorted);
+    }
+
+
+    SharedIndex SharedIndex::adopt_ticks(std::shared_ptr<const std::int64_t> ticks, arma::uword n) {
+        bool sorted = std::is_sorted(ticks.get(), ticks.get() + n);
+        return adopt_ticks(std::move(ticks), n, sorted);
+    }
+
+
+    const arma::vec &SharedIndex::labels() const {
+        std::shared_ptr<const arma::vec> current = std::atomic_load(&exactTicks->labels);
+        if (!current) {
+            // Threads racing here each convert the ticks, but only the first to finish keeps its labels.
+            auto fresh = std::make_shared<arma::vec>(exactTicks->n);
+            const std::int64_t *ticks = exactTicks->values.get();
+            for (arma::uword i = 0; i < exactTicks->n; i++) {
+                (*fresh)[i] = static_cast<double>(ticks[i]);
+            }
+            std::shared_ptr<const arma::vec> built = std::move(fresh);
+            current = std::atomic_compare_exchange_strong(&exactTicks->labels, &current, built) ? built : current;
+        }
+        return *current;
+    }
+
+
+    bool SharedIndex::shares_memory_with(const SharedIndex &other) const {
+        return data == other.data && exactTicks == other.exactTicks;
+    }
+
+
+    SharedIndex SharedIndex::elem(const arma::uvec &positions) const {
+        if (!exactTicks) {
+            return SharedIndex(data->elem(positions));
+        }
+        std::vector<std::int64_t> ticks(positions.n_elem);
+        for (arma::uword i = 0; i < positions.n_elem; i++) {
+            if (positions[i] >= exactTicks->n) {
+                throw std::out_of_range("SharedIndex::elem: position out of bounds");
+            }
+            ticks[i] = exactTicks->values.get()[positions[i]];
+        }
+        return from_ticks(std::move(ticks));
+    }
+
+
+    SharedIndex SharedIndex::head(arma::uword n) const {
+        if (!exactTicks) {
+            return SharedIndex(data->head(n));
+        }
+        const std::int64_t *ticks = exactTicks->values.get();
+        return from_ticks(std::vector<std::int64_t>(ticks, ticks + n));
+    }
+
+
+    SharedIndex SharedIndex::tail(arma::uword n) const {
+        if (!exactTicks) {
+            return SharedIndex(data->tail(n));
+        }
+        const std::int64_t *ticks = exactTicks->values.get() + exactTicks->n;
+        return from_ticks(std::vector<std::int64_t>(ticks - n, ticks));
+    }
+
+
+    arma::uvec SharedIndex::find_first(const arma::vec &labels) const {
+        const arma::vec &index = **this;
+        const double *begin = index.memptr();
+        const double *end = begin + index.n_elem;
+
+        std::vector<arma::uword> positions;
+        positions.reserve(labels.n_elem);
+
+        if (sorted) {
+            for (double label : labels) {
+                const double *it = std::lower_bound(begin, end, label);
+                if (it != end && *it == label) {
+                    positions.push_back(it - begin);
+                }
+            }
+        } else {
+            std::unordered_map<double, arma::uword> first_position;
+            first_position.reserve(index.n_elem);
+            for (arma::uword i = 0; i < index.n_elem; i++) {
+                // emplace keeps the existing entry, so duplicated labels map to their first position.
+                first_position.emplace(begin[i], i);
+            }
+            for (double label : labels) {
+                auto found = first_position.find(label);
+                if (found != first_position.end()) {
+                    positions.push_back(found->second);
+                }
+            }
+        }
+
+        return arma::conv_to<arma::uvec>::from(positions);
+    }
+
+
+    arma::uvec SharedIndex::find_all(double label) const {
+        const arma::vec &index = **this;
+        if (!sorted) {
+            return arma::find(index == label);
+        }
+
+        const double *begin = index.memptr();
+        const double *end = begin + index.n_elem;
+        auto range = std::equal_range(begin, end, label);
+        if (range.first == range.second) {
+            return arma::uvec();
+        }
+        return arma::regspace<arma::uvec>(range.first - begin, range.second - begin - 1);
+    }
+
+}  // polars
@@ -0,0 +1,135 @@
+#ifndef POLARS_SHAREDINDEX_H
+#define POLARS_SHAREDINDEX_H
+
+#include "armadillo"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace polars {
+
+    /**
+     * Read-only index storage, shared between every Series and SeriesMask derived from the same source.
+     *
+     * Element-wise operations leave the index unchanged so they pass on the SharedIndex, which only bumps a reference
+     * count, rather than copying the data. The index is never modified in place, so no copy is ever needed on write.
+     *
+     * Whether the index is sorted is worked out once, on construction, so that label lookups can use a binary search
+     * on sorted indices (the usual case for time series) rather than scanning the whole index per label.
+     *
+     * An index of integer tick counts, such as the time points of a TimeSeries, holds the counts themselves, as
+     * doubles are only exact up to 2^53, and only builds the double labels the first time they are asked for - by a
+     * label lookup, alignment or rolling window, say - after which every copy of the index shares them. Slicing passes
+     * the counts on; indices built any other way have none.
+     */
+    class SharedIndex {
+    public:
+        explicit SharedIndex(const arma::vec &index);
+
+        explicit SharedIndex(arma::vec &&index);
+
+        /**
+         * Index over storage owned elsewhere, e.g. a vector over memory-mapped pages whose deleter unmaps them. Given
+         * sorted, the index isn't scanned to find out.
+         */
+        static SharedIndex adopt(std::shared_ptr<const arma::vec> index, bool sorted);
+
+        static SharedIndex adopt(std::shared_ptr<const arma::vec> index);
+
+        /**
+         * Index of tick counts, labelled by the counts as doubles.
+         */
+        static SharedIndex from_ticks(std::vector<std::int64_t> ticks);
+
+        /**
+         * Index of n tick counts owned elsewhere, e.g. in a memory-mapped file or an Arrow buffer; ticks keeps the
+         * owner alive. Given sorted, the counts aren't scanned to find out.
+         */
+        static SharedIndex adopt_ticks(std::shared_ptr<const std::int64_t> ticks, arma::uword n, bool sorted);
+
+        static SharedIndex adopt_ticks(std::shared_ptr<const std::int64_t> ticks, arma::uword n);
+
+        inline const arma::vec &operator*() const {
+            return data ? *data : labels();
+        }
+
+        inline const arma::vec *operator->() const {
+            return &**this;
+        }
+
+        inline arma::uword size() const {
+            return data ? data->n_elem : exactTicks->n;
+        }
+
+        bool shares_memory_with(const SharedIndex &other) const;
+
+        inline bool has_ticks() const {
+            return exactTicks != nullptr;
+        }
+
+        /**
+         * The tick counts the index was built from; only valid if has_ticks().
+         */
+        inline const std::int64_t *ticks() const {
+            return exactTicks->values.get();
+        }
+
+        /**
+         * Index of the labels at positions, and of their tick counts if there are any.
+         */
+        SharedIndex elem(const arma::uvec &positions) const;
+
+        SharedIndex head(arma::uword n) const;
+
+        SharedIndex tail(arma::uword n) const;
+
+        /**
+         * True if the index is in non-decreasing order and contains no NANs.
+         */
+        inline bool is_sorted() const {
+            return sorted;
+        }
+
+        /**
+         * Position of the first occurrence of each label, in the order of the labels. Labels not in the index are
+         * skipped.
+         *
+         * O(k log n) for a sorted index, otherwise O(n + k) via a hash of the index built for the call.
+         */
+        arma::uvec find_first(const arma::vec &labels) const;
+
+        /**
+         * Positions of every occurrence of label, in index order.
+         */
+        arma::uvec find_all(double label) const;
+
+    private:
+        // Tag for the constructors used by adopt and adopt_ticks, which mustn't be confused with brace-initialised
+        // vectors.
+        struct Adopted {};
+
+        SharedIndex(Adopted, std::shared_ptr<const arma::vec> index, bool sorted);
+
+        // Tick counts, and their labels once built, shared between every copy of the index.
+        struct Ticks {
+            std::shared_ptr<const std::int64_t> values;
+            arma::uword n;
+            mutable std::shared_ptr<const arma::vec> labels;
+        };
+
+        SharedIndex(Adopted, std::shared_ptr<const Ticks> ticks, bool sorted);
+
+        const arma::vec &labels() const;
+
+        // Labels of an index without ticks, and the ticks of one with them; exactly one is set.
+        std::shared_ptr<const arma::vec> data;
+        std::shared_ptr<const Ticks> exactTicks;
+        bool sorted;
+    };
+
+}  // polars
+
+
+#endif //POLARS_SHAREDINDEX_H
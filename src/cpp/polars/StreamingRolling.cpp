@@ -0,0 +1,106 @@
+#include "StreamingRolling.h"
+
+#include "Series.h"
+
+#include <cmath>
+#include <stdexcept>
+
+
+namespace polars {
+
+    StreamingRolling::StreamingRolling(arma::uword windowSize, const WindowProcessor &processor,
+                                       arma::uword minPeriods)
+            : windowSize(windowSize),
+              minPeriods(minPeriods == 0 ? windowSize : minPeriods),
+              defaultValue(processor.defaultValue()),
+              accumulator(processor.accumulator()),
+              timestamps(windowSize),
+              values(windowSize) {
+        if (windowSize == 0) {
+            throw std::invalid_argument("StreamingRolling: windowSize must be positive");
+        }
+        if (!accumulator) {
+            throw std::invalid_argument("StreamingRolling: the processor must support incremental updates");
+        }
+    }
+
+
+    double StreamingRolling::push(double timestamp, double value) {
+        if (count > 0 && timestamp < timestamps[(first + count - 1) % windowSize]) {
+            throw std::invalid_argument("StreamingRolling::push: timestamps must not decrease");
+        }
+
+        bool wrapped = false;
+        if (count == windowSize) {
+            double leaving = values[first];
+            if (std::isfinite(leaving)) {
+                accumulator->remove(leaving);
+                finiteCount--;
+            }
+            first = (first + 1) % windowSize;
+            count--;
+            wrapped = first == 0;
+        }
+
+        arma::uword position = (first + count) % windowSize;
+        timestamps[position] = timestamp;
+        values[position] = value;
+        count++;
+        if (std::isfinite(value)) {
+            accumulator->add(value);
+            finiteCount++;
+        }
+
+        // Removing values from running sums and variances leaves rounding errors behind, which add up over a long
+        // stream. Starting again from the window each time the ring wraps around bounds them, at O(1) amortised cost.
+        if (wrapped) {
+            rebuild();
+        }
+
+        return this->value();
+    }
+
+
+    double StreamingRolling::value() const {
+        if (finiteCount == 0 || finiteCount < minPeriods) {
+            return defaultValue;
+        }
+        return accumulator->value();
+    }
+
+
+    arma::uword StreamingRolling::size() const {
+        return count;
+    }
+
+
+    Series StreamingRolling::window() const {
+        arma::vec windowTimestamps(count);
+        arma::vec windowValues(count);
+        for (arma::uword i = 0; i < count; i++) {
+            windowTimestamps[i] = timestamps[(first + i) % windowSize];
+            windowValues[i] = values[(first + i) % windowSize];
+        }
+        return Series(windowValues, windowTimestamps);
+    }
+
+
+    void StreamingRolling::rebuild() {
+        accumulator->reset();
+        for (arma::uword i = 0; i < count; i++) {
+            double value = values[(first + i) % windowSize];
+            if (std::isfinite(value)) {
+                accumulator->add(value);
+            }
+        }
+    }
+
+
+    void StreamingRolling::reset() {
+        accumulator->reset();
+        first = 0;
+        count = 0;
+        finiteCount = 0;
+    }
+
+}  // polars
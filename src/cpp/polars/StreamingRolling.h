@@ -0,0 +1,69 @@
+#ifndef POLARS_STREAMINGROLLING_H
+#define POLARS_STREAMINGROLLING_H
+
+#include "WindowProcessor.h"
+
+#include "armadillo"
+
+#include <memory>
+
+
+namespace polars {
+    class Series;
+
+    /**
+     * Rolling aggregate of a live stream of values, updated one push at a time instead of re-rolling a whole Series.
+     *
+     * The window is the last windowSize values pushed, i.e. a trailing window rather than the centred one of
+     * Series::rolling. It is kept in a fixed-size ring buffer, so memory does not grow with the length of the stream.
+     * Each push updates the processor's WindowAccumulator, which is O(1) for count, sum, mean, std, min and max, and
+     * O(log windowSize) for quantiles. Only processors with an accumulator (e.g. those used by Rolling) are supported.
+     * The accumulator is rebuilt from the window every windowSize pushes, so rounding errors don't build up.
+     *
+     * As in Series::rolling, NANs take up a place in the window but are not aggregated, and the processor's default
+     * value is returned while the window holds fewer than minPeriods finite values.
+     */
+    class StreamingRolling {
+    public:
+        StreamingRolling(arma::uword windowSize,
+                         const WindowProcessor &processor,
+                         arma::uword minPeriods = 0 /* 0 treated as windowSize */);
+
+        /**
+         * Add the next value to the window, dropping the oldest once it is full, and return the updated aggregate.
+         * Timestamps must not decrease.
+         */
+        double push(double timestamp, double value);
+
+        // The aggregate of the current window.
+        double value() const;
+
+        // Number of values in the window, including NANs.
+        arma::uword size() const;
+
+        // The values currently in the window, oldest first.
+        Series window() const;
+
+        void reset();
+
+    private:
+        // Recompute the accumulator from the values in the window.
+        void rebuild();
+
+        arma::uword windowSize;
+        arma::uword minPeriods;
+        double defaultValue;
+        std::unique_ptr<WindowAccumulator> accumulator;
+
+        // Ring buffer of the window: the oldest value is at position `first` and there are `count` of them.
+        arma::vec timestamps;
+        arma::vec values;
+        arma::uword first = 0;
+        arma::uword count = 0;
+        arma::uword finiteCount = 0;
+    };
+
+}  // polars
+
+
+#endif //POLARS_STREAMINGROLLING_H
@@ -0,0 +1,180 @@
+#include "ThreadPool.h"
+
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+
+namespace polars {
+
+    ThreadPool::ThreadPool(unsigned threads) : threads(threads), pending(0) {
+        if (this->threads == 0) {
+            this->threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // One queue per thread; the last one is filled for, and drained by, callers of parallel_for.
+        for (unsigned i = 0; i < this->threads; i++) {
+            queues.emplace_back(new Queue());
+        }
+        for (unsigned i = 0; i + 1 < this->threads; i++) {
+            workers.emplace_back(&ThreadPool::worker, this, i);
+        }
+    }
+
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &thread : workers) {
+            thread.join();
+        }
+    }
+
+
+    unsigned ThreadPool::size() const {
+        return threads;
+    }
+
+
+    ThreadPool &ThreadPool::global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+
+    bool ThreadPool::try_pop(unsigned queue, Task &task) {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        if (queues[queue]->tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues[queue]->tasks.back());
+        queues[queue]->tasks.pop_back();
+        pending--;
+        return true;
+    }
+
+
+    bool ThreadPool::try_steal(unsigned first, Task &task) {
+        for (unsigned i = 0; i < threads; i++) {
+            Queue &queue = *queues[(first + i) % threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                pending--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    void ThreadPool::worker(unsigned id) {
+        while (true) {
+            Task task;
+            if (try_pop(id, task) || try_steal(id + 1, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait(lock, [this] { return stopping || pending > 0; });
+            if (stopping && pending == 0) {
+                return;
+            }
+        }
+    }
+
+
+    void ThreadPool::parallel_for(arma::uword n, const std::function<void(arma::uword)> &f) {
+        if (n == 0) {
+            return;
+        }
+
+        struct Batch {
+            std::atomic<arma::uword> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+#ifdef POLARS_INSTRUMENTATION
+            std::thread::id caller;
+            std::atomic<std::uint64_t> allocations;
+            std::atomic<std::uint64_t> bytes;
+#endif
+        };
+        auto batch = std::make_shared<Batch>();
+        batch->remaining = n;
+#ifdef POLARS_INSTRUMENTATION
+        batch->caller = std::this_thread::get_id();
+        batch->allocations = 0;
+        batch->bytes = 0;
+#endif
+
+        for (arma::uword i = 0; i < n; i++) {
+            Task task = [batch, &f, i] {
+                try {
+#ifdef POLARS_INSTRUMENTATION
+                    // Allocations made on another thread are moved over to the caller's, for its scopes to count.
+                    if (std::this_thread::get_id() != batch->caller) {
+                        instrumentation::AllocationCount before = instrumentation::thread_allocations();
+                        f(i);
+                        instrumentation::AllocationCount after = instrumentation::thread_allocations();
+                        instrumentation::AllocationCount made = {after.allocations - before.allocations,
+                                                                 after.bytes - before.bytes};
+                        instrumentation::uncharge_allocations(made);
+                        batch->allocations += made.allocations;
+                        batch->bytes += made.bytes;
+                    } else {
+                        f(i);
+                    }
+#else
+                    f(i);
+#endif
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    if (!batch->error) {
+                        batch->error = std::current_exception();
+                    }
+                }
+                if (--batch->remaining == 0) {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    batch->done.notify_all();
+                }
+            };
+
+            Queue &queue = *queues[i % threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            pending += n;
+        }
+        wake.notify_all();
+
+        // Help out rather than block, starting from the callers' queue.
+        while (batch->remaining > 0) {
+            Task task;
+            if (try_steal(threads - 1, task)) {
+                task();
+            } else {
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                batch->done.wait_for(lock, std::chrono::milliseconds(1), [&batch] { return batch->remaining == 0; });
+            }
+        }
+
+#ifdef POLARS_INSTRUMENTATION
+        instrumentation::charge_allocations({batch->allocations, batch->bytes});
+#endif
+
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+    }
+
+}  // polars
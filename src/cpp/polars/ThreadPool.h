@@ -0,0 +1,80 @@
+#ifndef POLARS_THREADPOOL_H
+#define POLARS_THREADPOOL_H
+
+#include "armadillo"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace polars {
+
+    /**
+     * Work-stealing thread pool for running independent pieces of work, such as rolling over many columns, in parallel.
+     *
+     * Each worker has its own queue, takes work from the back of it, and steals from the front of the others' queues
+     * when it runs out. The thread that calls parallel_for works through the queues too until its tasks are done, so a
+     * pool of size 1 runs everything on the calling thread and nested parallel_for calls cannot deadlock.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @param threads the number of threads that run tasks, including the caller of parallel_for; 0 uses one per
+         * hardware thread.
+         */
+        explicit ThreadPool(unsigned threads = 0);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        unsigned size() const;
+
+        /**
+         * Call f(0) ... f(n - 1) across the pool and return once they have all finished. If any call throws, the first
+         * exception is rethrown here after the others have completed.
+         */
+        void parallel_for(arma::uword n, const std::function<void(arma::uword)> &f);
+
+        /**
+         * Pool with one thread per hardware thread, shared by the default arguments of the parallel APIs.
+         */
+        static ThreadPool &global();
+
+    private:
+        typedef std::function<void()> Task;
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        bool try_pop(unsigned queue, Task &task);
+
+        bool try_steal(unsigned first, Task &task);
+
+        void worker(unsigned id);
+
+        unsigned threads;
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        // Tasks queued but not yet started. Signed, as a task can be taken just before it is counted.
+        std::atomic<arma::sword> pending;
+        bool stopping = false;
+    };
+
+}  // polars
+
+
+#endif //POLARS_THREADPOOL_H
@@ -8,6 +8,7 @@
 #include "Series.h"
 
 #include "TimeSeriesMask.h"
+#include "Timestamps.h"
 
 #include "armadillo"
 #include "date/date.h"
@@ -15,6 +16,7 @@
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <string>
 #include <vector>
@@ -25,6 +27,16 @@ namespace polars {
     using namespace std::chrono;
     typedef std::chrono::duration<double> unix_epoch_seconds;
 
+    template<class TimePointType>
+    class TimeResampler;
+
+    /**
+     * Series indexed by time points. The index labels each value with the tick count of its time point's duration as a
+     * double, which is exact up to 2^53 ticks - until the year 2255 for microseconds, but not for nanosecond epochs - so
+     * it also keeps the tick counts as int64s. Element-wise operations share the index, and head, tail, loc, iloc,
+     * dropna and boolean indexing slice the tick counts with it, so timestamps() and to_timeseries_map() give back the
+     * time points exactly. Label lookups, alignment, rolling and resampling go by the double labels.
+     */
     template<class TimePointType>
     class TimeSeries : public Series {
     using Mask = TimeSeriesMask<TimePointType>;
@@ -33,10 +45,13 @@ namespace polars {
         using Series::loc;
         using Series::head;
         using Series::tail;
+        using Series::rolling;
+        using Series::resample;
 
         TimeSeries() = default;
 
-        TimeSeries(arma::vec v0, std::vector<TimePointType> t0) : Series(v0, chrono_to_double_vector(t0)) {};
+        TimeSeries(arma::vec v0, const std::vector<TimePointType> &t0)
+                : Series(std::move(v0), SharedIndex::from_ticks(chrono_to_ticks_vector(t0))) {};
 
         /**
          * Converting constructor - this takes a TimeSeriesMask and creates a TimeSeries from it.
@@ -44,18 +59,18 @@ namespace polars {
          * This is intentionally implicit (not marked explicit) so that a function expecting a TimeSeries can be passed
          * a TimeSeriesMask and it will be automatically converted since this is a loss-less process.
          */
-        TimeSeries(const Mask &sm) : Series(arma::conv_to<arma::vec>::from(sm.values()), sm.index()) {}
+        TimeSeries(const Mask &sm) : Series(sm) {}
 
         static TimeSeries from_map(const std::map<TimePointType, double> &iv_map) {
-            arma::vec index(iv_map.size());
+            std::vector<std::int64_t> ticks(iv_map.size());
             arma::vec values(iv_map.size());
             int i = 0;
             for (auto& pair : iv_map) {
-                index[i] = chrono_to_double(pair.first);
+                ticks[i] = chrono_to_ticks(pair.first);
                 values[i] = pair.second;
                 ++i;
             }
-            return {values, index};
+            return TimeSeries(std::move(values), SharedIndex::from_ticks(std::move(ticks)));
         }
 
         /**
@@ -63,43 +78,68 @@ namespace polars {
          */
         static TimeSeries from_series(const Series& ser) {return ser;};
 
+        static TimeSeries from_series(Series&& ser) {return TimeSeries(std::move(ser));};
+
         // TODO: Rename to_map once we sort out base methods, etc.
         std::map<TimePointType, double> to_timeseries_map() const {
             std::map<TimePointType, double> m;
 
-            std::vector<TimePointType> timepoints = double_to_chrono_vector(index());
+            Timestamps<TimePointType> idx = timestamps();
+            const arma::vec &vals = values();
 
-            // Put pairs into map
-            for(int i = 0; i < size(); i++) {
-                m.insert(std::make_pair(timepoints[i], values()[i]));
+            // The index is normally sorted, so hinting at the end makes each insert O(1).
+            for (arma::uword i = 0; i < size(); i++) {
+                m.emplace_hint(m.end(), idx[i], vals[i]);
             }
 
             return m;
         };
 
-        // TODO:: Make this more efficient.
         TimeSeries loc(const std::vector<TimePointType> &index_labels) const {
             return Series::loc(chrono_to_double_vector(index_labels));
         };
 
         TimeSeries head(int n) const  {
-            Series ser_head = Series::head(n);
-            return {ser_head.values(), double_to_chrono_vector(ser_head.index())};
+            return Series::head(n);
         };
 
         TimeSeries tail(int n) const  {
-            Series ser_tail = Series::tail(n);
-            return {ser_tail.values(), double_to_chrono_vector(ser_tail.index())};
+            return Series::tail(n);
+        };
+
+        /**
+         * Rolling windows covering a span of time, e.g. ts.rolling(std::chrono::minutes(5)).mean(), rather than a
+         * number of values, for irregularly sampled data. The window for each timestamp covers (timestamp - window,
+         * timestamp], and by default needs just one finite value, as in pandas.
+         */
+        template<class Rep, class Period>
+        OffsetRolling rolling(std::chrono::duration<Rep, Period> window, arma::uword minPeriods = 1) const {
+            // The index holds counts of TimePointType::duration, so express the window in the same units.
+            double offset = std::chrono::duration<double, typename TimePointType::period>(window).count();
+            return rolling_offset(offset, minPeriods);
         };
 
-        std::vector<TimePointType> timestamps() const {
-            // Pass indices and return vector of timepoints
-            return double_to_chrono_vector(index());
+        /**
+         * Aggregate into consecutive buckets of the given duration, e.g. ts.resample(std::chrono::minutes(1)).ohlc() for
+         * minute bars. Each bucket is labelled with its start time.
+         */
+        template<class Rep, class Period>
+        TimeResampler<TimePointType> resample(std::chrono::duration<Rep, Period> bucket) const {
+            double width = std::chrono::duration<double, typename TimePointType::period>(bucket).count();
+            return TimeResampler<TimePointType>(Series::resample(width));
+        };
+
+        /**
+         * The time points of the index, as a view over it rather than a copy.
+         */
+        Timestamps<TimePointType> timestamps() const {
+            return Timestamps<TimePointType>(shared_index());
         };
 
     private:
-        TimeSeries(arma::vec v0, arma::vec t0) : Series(v0, t0) {};
+        TimeSeries(arma::vec v0, const SharedIndex &t0) : Series(std::move(v0), t0) {};
         TimeSeries(const Series& ser) : Series(ser) {};
+        TimeSeries(Series&& ser) : Series(std::move(ser)) {};
 
         static double chrono_to_double(TimePointType timepoint){
             return time_point_cast<typename TimePointType::duration>(timepoint).time_since_epoch().count();
@@ -114,23 +154,48 @@ namespace polars {
             return tstamps;
         };
 
-
-        static TimePointType double_to_chrono(double timestamp){
-            return TimePointType{typename TimePointType::duration(std::lround(timestamp))};
+        static std::int64_t chrono_to_ticks(TimePointType timepoint){
+            return time_point_cast<typename TimePointType::duration>(timepoint).time_since_epoch().count();
         };
 
-        static std::vector<TimePointType> double_to_chrono_vector(const arma::vec& tstamps){
-
-            std::vector<TimePointType> timepoints;
+        static std::vector<std::int64_t> chrono_to_ticks_vector(const std::vector<TimePointType>& timepoints){
 
-            for(const auto &value:tstamps){
-                timepoints.push_back(double_to_chrono(value));
+            std::vector<std::int64_t> ticks(timepoints.size());
+            for(std::size_t i = 0; i < timepoints.size() ; i++){
+                ticks[i] = chrono_to_ticks(timepoints[i]);
             }
-            return timepoints;
+            return ticks;
         };
 
     };
 
+    /**
+     * Resampler that returns TimeSeries of the same time point type.
+     */
+    template<class TimePointType>
+    class TimeResampler {
+    using Result = TimeSeries<TimePointType>;
+    public:
+        explicit TimeResampler(const Resampler &resampler) : resampler(resampler) {}
+
+        Result sum() const { return Result::from_series(resampler.sum()); }
+        Result mean() const { return Result::from_series(resampler.mean()); }
+        Result min() const { return Result::from_series(resampler.min()); }
+        Result max() const { return Result::from_series(resampler.max()); }
+        Result first() const { return Result::from_series(resampler.first()); }
+        Result last() const { return Result::from_series(resampler.last()); }
+        Result count() const { return Result::from_series(resampler.count()); }
+
+        OHLC<Result> ohlc() const {
+            OHLC<Series> bars = resampler.ohlc();
+            return {Result::from_series(bars.open), Result::from_series(bars.high),
+                    Result::from_series(bars.low), Result::from_series(bars.close)};
+        }
+
+    private:
+        Resampler resampler;
+    };
+
     typedef TimeSeries<time_point<system_clock, milliseconds>> MillisecondsTimeSeries;
     typedef TimeSeries<time_point<system_clock, seconds>> SecondsTimeSeries;
     typedef TimeSeries<time_point<system_clock, minutes>> MinutesTimeSeries;
@@ -147,9 +212,6 @@ namespace polars {
 template<class TimePointType>
 std::ostream &operator<<(std::ostream &os, const polars::TimeSeries<TimePointType> &ts) {
 
-    std::vector<TimePointType> timestamps = ts.timestamps();
-    arma::vec vals = ts.values();
-
     os << "Timeseries:\n";
 
     for (auto& pair : ts.head(5).to_timeseries_map()) {
@@ -6,6 +6,7 @@
 #define POLARS_TIMESERIESMASK_H
 
 #include "SeriesMask.h"
+#include "Timestamps.h"
 
 #include "armadillo"
 #include "date/date.h"
@@ -13,6 +14,7 @@
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <string>
 #include <vector>
@@ -34,18 +36,19 @@ namespace polars {
 
         TimeSeriesMask() = default;
 
-        TimeSeriesMask(arma::uvec v0, std::vector<TimePointType> t0) : SeriesMask(v0 > 0, chrono_to_double_vector(t0)) {};
+        TimeSeriesMask(const arma::uvec &v0, const std::vector<TimePointType> &t0)
+                : SeriesMask(arma::uvec(v0 > 0), SharedIndex::from_ticks(chrono_to_ticks_vector(t0))) {};
 
         static TimeSeriesMask from_map(const std::map<TimePointType, bool> &iv_map) {
-            arma::vec index(iv_map.size());
+            std::vector<std::int64_t> ticks(iv_map.size());
             arma::uvec values(iv_map.size());
             int i = 0;
             for (auto& pair : iv_map) {
-                index[i] = chrono_to_double(pair.first);
+                ticks[i] = chrono_to_ticks(pair.first);
                 values[i] = pair.second;
                 ++i;
             }
-            return {values, index};
+            return TimeSeriesMask(std::move(values), SharedIndex::from_ticks(std::move(ticks)));
         }
 
         /**
@@ -53,62 +56,42 @@ namespace polars {
          */
         static TimeSeriesMask from_series_mask(const SeriesMask& mask) {return mask;};
 
-        std::vector<TimePointType> timestamps() const {
-            // Pass indices and return vector of timepoints
-            return double_to_chrono_vector(index());
+        /**
+         * The time points of the index, as a view over it rather than a copy.
+         */
+        Timestamps<TimePointType> timestamps() const {
+            return Timestamps<TimePointType>(shared_index());
         };
 
         // TODO: Rename to_map once we sort out base methods, etc.
         std::map<TimePointType, bool> to_timeseries_map() const {
-
             std::map<TimePointType, bool> m;
 
-            std::vector<TimePointType> timepoints = double_to_chrono_vector(index());
+            Timestamps<TimePointType> idx = timestamps();
+            const BitMask &vals = bits();
 
-            // Put pairs into map
-            for(int i = 0; i < size(); i++) {
-                m.insert(std::make_pair(timepoints[i], values()[i]));
+            // The index is normally sorted, so hinting at the end makes each insert O(1).
+            for (arma::uword i = 0; i < size(); i++) {
+                m.emplace_hint(m.end(), idx[i], vals[i]);
             }
 
             return m;
         };
 
-        // TODO:: Make this more efficient.
         TimeSeriesMask loc(const std::vector<TimePointType> &index_labels) const {
-            std::vector<double> indices;
-
-            // Turn time_points to doubles
-            auto tstamps = chrono_to_double_vector(index_labels);
-
-            for (int j = 0; j < tstamps.n_elem; j++) {
-
-                arma::uvec idx = arma::find(index() == tstamps[j]);
-
-                if (!idx.empty()) {
-                    indices.push_back(idx[0]);
-                }
-            }
-
-            if (indices.empty()) {
-                return {};
-            } else {
-                arma::uvec indices_v = arma::conv_to<arma::uvec>::from(indices);
-                return {values().elem(indices_v), double_to_chrono_vector(index().elem(indices_v))};
-            }
+            return SeriesMask::loc(chrono_to_double_vector(index_labels));
         };
 
         TimeSeriesMask head(int n) const  {
-            auto ser_head = SeriesMask::head(n);
-            return {ser_head.values(), double_to_chrono_vector(ser_head.index())};
+            return SeriesMask::head(n);
         };
 
         TimeSeriesMask tail(int n) const  {
-            auto ser_tail = SeriesMask::tail(n);
-            return {ser_tail.values(), double_to_chrono_vector(ser_tail.index())};
+            return SeriesMask::tail(n);
         };
 
     private:
-        TimeSeriesMask(arma::uvec v0, arma::vec t0) : SeriesMask(v0, t0) {};
+        TimeSeriesMask(arma::uvec v0, const SharedIndex &t0) : SeriesMask(std::move(v0), t0) {};
         TimeSeriesMask(const SeriesMask& mask) : SeriesMask(mask) {};
 
         static double chrono_to_double(TimePointType timepoint){
@@ -124,19 +107,17 @@ namespace polars {
             return tstamps;
         };
 
-
-        static TimePointType double_to_chrono(double timestamp){
-            return TimePointType{typename TimePointType::duration(std::lround(timestamp))};
+        static std::int64_t chrono_to_ticks(TimePointType timepoint){
+            return time_point_cast<typename TimePointType::duration>(timepoint).time_since_epoch().count();
         };
 
-        static std::vector<TimePointType> double_to_chrono_vector(const arma::vec& tstamps){
-
-            std::vector<TimePointType> timepoints;
+        static std::vector<std::int64_t> chrono_to_ticks_vector(const std::vector<TimePointType>& timepoints){
 
-            for(const auto &value:tstamps){
-                timepoints.push_back(double_to_chrono(value));
+            std::vector<std::int64_t> ticks(timepoints.size());
+            for(std::size_t i = 0; i < timepoints.size() ; i++){
+                ticks[i] = chrono_to_ticks(timepoints[i]);
             }
-            return timepoints;
+            return ticks;
         };
 
     };
@@ -157,9 +138,6 @@ namespace polars {
 template<class TimePointType>
 std::ostream &operator<<(std::ostream &os, const polars::TimeSeriesMask<TimePointType> &ts) {
 
-    std::vector<TimePointType> timestamps = ts.timestamps();
-    arma::uvec vals = ts.values();
-
     os << "TimeSeriesMask:\n";
 
     for (auto& pair : ts.head(5).to_timeseries_map()) {
@@ -0,0 +1,133 @@
+#ifndef POLARS_TIMESTAMPS_H
+#define POLARS_TIMESTAMPS_H
+
+#include "SharedIndex.h"
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+
+namespace polars {
+
+    /**
+     * Read-only view of the time points of a TimeSeries or TimeSeriesMask, read from its index on access rather than
+     * copied out: from the exact tick counts when the index has them, otherwise by rounding its labels.
+     *
+     * The view shares the index, so it stays valid after the series has gone. Convert it to a std::vector for a copy.
+     */
+    template<class TimePointType>
+    class Timestamps {
+    public:
+        typedef TimePointType value_type;
+        typedef std::size_t size_type;
+
+        class const_iterator {
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef TimePointType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const TimePointType *pointer;
+            typedef TimePointType reference;
+
+            const_iterator(const Timestamps *timestamps, size_type i) : timestamps(timestamps), i(i) {}
+
+            TimePointType operator*() const {
+                return (*timestamps)[i];
+            }
+
+            const_iterator &operator++() {
+                ++i;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator previous = *this;
+                ++i;
+                return previous;
+            }
+
+            bool operator==(const const_iterator &other) const {
+                return i == other.i;
+            }
+
+            bool operator!=(const const_iterator &other) const {
+                return i != other.i;
+            }
+
+        private:
+            const Timestamps *timestamps;
+            size_type i;
+        };
+
+        typedef const_iterator iterator;
+
+        explicit Timestamps(const SharedIndex &index) : index(index) {}
+
+        inline size_type size() const {
+            return index.size();
+        }
+
+        inline bool empty() const {
+            return index.size() == 0;
+        }
+
+        TimePointType operator[](size_type i) const {
+            using Duration = typename TimePointType::duration;
+            using Rep = typename Duration::rep;
+            if (index.has_ticks()) {
+                return TimePointType(Duration(static_cast<Rep>(index.ticks()[i])));
+            }
+            return TimePointType(Duration(static_cast<Rep>(std::llround((*index)[i]))));
+        }
+
+        const_iterator begin() const {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(this, size());
+        }
+
+        operator std::vector<TimePointType>() const {
+            std::vector<TimePointType> timepoints;
+            timepoints.reserve(size());
+            for (size_type i = 0; i < size(); i++) {
+                timepoints.push_back((*this)[i]);
+            }
+            return timepoints;
+        }
+
+        friend bool operator==(const Timestamps &lhs, const std::vector<TimePointType> &rhs) {
+            if (lhs.size() != rhs.size()) {
+                return false;
+            }
+            for (size_type i = 0; i < rhs.size(); i++) {
+                if (lhs[i] != rhs[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator==(const std::vector<TimePointType> &lhs, const Timestamps &rhs) {
+            return rhs == lhs;
+        }
+
+        friend bool operator!=(const Timestamps &lhs, const std::vector<TimePointType> &rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator!=(const std::vector<TimePointType> &lhs, const Timestamps &rhs) {
+            return !(rhs == lhs);
+        }
+
+    private:
+        SharedIndex index;
+    };
+
+}  // polars
+
+
+#endif //POLARS_TIMESTAMPS_H
@@ -4,6 +4,7 @@
 
 #include "WindowProcessor.h"
 
+#include "Instrumentation.h"
 #include "Series.h"
 #include "numc.h"
 
@@ -44,11 +45,21 @@ namespace polars {
     }
 
 
+    std::unique_ptr<WindowAccumulator> Quantile::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new QuantileAccumulator(quantile));
+    }
+
+
     double polars::Sum::processWindow(const Series &window, const arma::vec& weights) const {
         return polars::numc::sum_finite((weights % window.values()));
     }
 
 
+    std::unique_ptr<WindowAccumulator> polars::Sum::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new SumAccumulator());
+    }
+
+
     polars::Count::Count(double default_value) : default_value(default_value) {}
 
 
@@ -57,6 +68,11 @@ namespace polars {
     }
 
 
+    std::unique_ptr<WindowAccumulator> polars::Count::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new CountAccumulator());
+    }
+
+
     polars::Mean::Mean(double default_value) : default_value(default_value) {}
 
 
@@ -68,6 +84,11 @@ namespace polars {
     }
 
 
+    std::unique_ptr<WindowAccumulator> polars::Mean::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new MeanAccumulator());
+    }
+
+
     polars::Std::Std(double default_value) : default_value(default_value) {}
 
 
@@ -77,6 +98,35 @@ namespace polars {
     }
 
 
+    std::unique_ptr<WindowAccumulator> polars::Std::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new StdAccumulator());
+    }
+
+
+    double polars::RollingMin::processWindow(const Series &window, const arma::vec& weights) const {
+        arma::vec v = weights % window.values();
+        v = v.elem(arma::find_finite(v));
+        return v.empty() ? NAN : v.min();
+    }
+
+
+    std::unique_ptr<WindowAccumulator> polars::RollingMin::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new ExtremumAccumulator(false));
+    }
+
+
+    double polars::RollingMax::processWindow(const Series &window, const arma::vec& weights) const {
+        arma::vec v = weights % window.values();
+        v = v.elem(arma::find_finite(v));
+        return v.empty() ? NAN : v.max();
+    }
+
+
+    std::unique_ptr<WindowAccumulator> polars::RollingMax::accumulator() const {
+        return std::unique_ptr<WindowAccumulator>(new ExtremumAccumulator(true));
+    }
+
+
     double polars::ExpMean::processWindow(const Series &window, const arma::vec& weights) const {
         // This ensures deals with NAs like pandas for the case ignore_na = False which is the default setting.
         arma::vec weights_for_sum = weights.elem(arma::find_finite(window.values()));
@@ -84,39 +134,286 @@ namespace polars {
         return polars::numc::sum_finite(weighted_values) / arma::sum(weights_for_sum);
     }
 
+    void SumAccumulator::accumulate(double value) {
+        double total = sum + value;
+        if (std::abs(sum) >= std::abs(value)) {
+            compensation += (sum - total) + value;
+        } else {
+            compensation += (value - total) + sum;
+        }
+        sum = total;
+    }
+
+    void SumAccumulator::add(double value) {
+        accumulate(value);
+        count++;
+    }
+
+    void SumAccumulator::remove(double value) {
+        accumulate(-value);
+        count--;
+        if (count == 0) {
+            // nothing left in the window, so drop any accumulated rounding error.
+            reset();
+        }
+    }
+
+    double SumAccumulator::value() const {
+        return sum + compensation;
+    }
+
+    void SumAccumulator::reset() {
+        count = 0;
+        sum = 0;
+        compensation = 0;
+    }
+
+
+    void CountAccumulator::add(double) {
+        count++;
+    }
+
+    void CountAccumulator::remove(double) {
+        count--;
+    }
+
+    double CountAccumulator::value() const {
+        return count;
+    }
+
+    void CountAccumulator::reset() {
+        count = 0;
+    }
+
+
+    void MeanAccumulator::add(double value) {
+        sum.add(value);
+        count++;
+    }
+
+    void MeanAccumulator::remove(double value) {
+        sum.remove(value);
+        count--;
+    }
+
+    double MeanAccumulator::value() const {
+        return sum.value() / count;
+    }
+
+    void MeanAccumulator::reset() {
+        sum.reset();
+        count = 0;
+    }
+
+
+    void StdAccumulator::add(double value) {
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    void StdAccumulator::remove(double value) {
+        if (count <= 1) {
+            reset();
+            return;
+        }
+        count--;
+        double delta = value - mean;
+        mean -= delta / count;
+        m2 -= delta * (value - mean);
+        if (m2 < 0) {
+            // guard against rounding taking the sum of squares negative.
+            m2 = 0;
+        }
+    }
+
+    double StdAccumulator::value() const {
+        if (count <= 1) {
+            return NAN;
+        }
+        return std::sqrt(m2 / (count - 1));
+    }
+
+    void StdAccumulator::reset() {
+        count = 0;
+        mean = 0;
+        m2 = 0;
+    }
+
+
+    ExtremumAccumulator::ExtremumAccumulator(bool maximum) : maximum(maximum) {}
+
+    void ExtremumAccumulator::add(double value) {
+        // Anything the new value dominates can never be the extreme of a later window.
+        while (!candidates.empty() && (maximum ? candidates.back() < value : candidates.back() > value)) {
+            candidates.pop_back();
+        }
+        candidates.push_back(value);
+    }
+
+    void ExtremumAccumulator::remove(double value) {
+        // The oldest value is either the current extreme or was already dominated and dropped.
+        if (!candidates.empty() && candidates.front() == value) {
+            candidates.pop_front();
+        }
+    }
+
+    double ExtremumAccumulator::value() const {
+        return candidates.empty() ? NAN : candidates.front();
+    }
+
+    void ExtremumAccumulator::reset() {
+        candidates.clear();
+    }
+
+
+    QuantileAccumulator::QuantileAccumulator(double quantile) : quantile(quantile) {}
+
+    void QuantileAccumulator::add(double value) {
+        if (!lower.empty() && value <= *lower.rbegin()) {
+            lower.insert(value);
+        } else {
+            upper.insert(value);
+        }
+        rebalance();
+    }
+
+    void QuantileAccumulator::remove(double value) {
+        // Every value in upper is >= the largest in lower, so anything at or below that must be in lower.
+        if (!lower.empty() && value <= *lower.rbegin()) {
+            lower.erase(lower.find(value));
+        } else {
+            upper.erase(upper.find(value));
+        }
+        rebalance();
+    }
+
+    void QuantileAccumulator::rebalance() {
+        arma::uword n = lower.size() + upper.size();
+        arma::uword target = (n == 0) ? 0 : (arma::uword) floor(quantile * ((double) n - 1)) + 1;
+
+        while (lower.size() > target) {
+            auto largest = std::prev(lower.end());
+            upper.insert(*largest);
+            lower.erase(largest);
+        }
+        while (lower.size() < target) {
+            auto smallest = upper.begin();
+            lower.insert(*smallest);
+            upper.erase(smallest);
+        }
+    }
+
+    double QuantileAccumulator::value() const {
+        arma::uword n = lower.size() + upper.size();
+        if (n == 0) {
+            return NAN;
+        }
+
+        // note, this is based on how q works in python numpy percentile rather than the more usual quantile defn.
+        double quantilePosition = quantile * ((double) n - 1);
+
+        if (double_is_int(quantilePosition)) {
+            return *lower.rbegin();
+        } else {
+            // interpolate estimate
+            arma::uword quantileIdx = floor(quantilePosition);
+            double fraction = quantilePosition - quantileIdx;
+            double below = *lower.rbegin();
+            double above = *upper.begin();
+            return below + (above - below) * fraction;
+        }
+    }
+
+    void QuantileAccumulator::reset() {
+        lower.clear();
+        upper.clear();
+    }
+
+
     Series Rolling::count() {
+        POLARS_INSTRUMENT("Rolling::count");
         return ts_.rolling(windowSize_, Count(), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::sum() {
+        POLARS_INSTRUMENT("Rolling::sum");
         return ts_.rolling(windowSize_, Sum(), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::mean() {
+        POLARS_INSTRUMENT("Rolling::mean");
         return ts_.rolling(windowSize_, Mean(), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::std() {
+        POLARS_INSTRUMENT("Rolling::std");
         return ts_.rolling(windowSize_, Std(), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::quantile(double q) {
+        POLARS_INSTRUMENT("Rolling::quantile");
         return ts_.rolling(windowSize_, Quantile(q), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::min() {
-        return ts_.rolling(windowSize_, Quantile(0.), minPeriods_, center_, symmetric_);
+        POLARS_INSTRUMENT("Rolling::min");
+        return ts_.rolling(windowSize_, RollingMin(), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::max() {
-        return ts_.rolling(windowSize_, Quantile(1.), minPeriods_, center_, symmetric_);
+        POLARS_INSTRUMENT("Rolling::max");
+        return ts_.rolling(windowSize_, RollingMax(), minPeriods_, center_, symmetric_);
     }
 
     Series Rolling::median() {
+        POLARS_INSTRUMENT("Rolling::median");
         return ts_.rolling(windowSize_, Quantile(0.5), minPeriods_, center_, symmetric_);
     }
 
+    Series OffsetRolling::count() {
+        POLARS_INSTRUMENT("OffsetRolling::count");
+        return ts_.rolling_offset(offset_, Count(), minPeriods_);
+    }
+
+    Series OffsetRolling::sum() {
+        POLARS_INSTRUMENT("OffsetRolling::sum");
+        return ts_.rolling_offset(offset_, Sum(), minPeriods_);
+    }
+
+    Series OffsetRolling::mean() {
+        POLARS_INSTRUMENT("OffsetRolling::mean");
+        return ts_.rolling_offset(offset_, Mean(), minPeriods_);
+    }
+
+    Series OffsetRolling::std() {
+        POLARS_INSTRUMENT("OffsetRolling::std");
+        return ts_.rolling_offset(offset_, Std(), minPeriods_);
+    }
+
+    Series OffsetRolling::quantile(double q) {
+        POLARS_INSTRUMENT("OffsetRolling::quantile");
+        return ts_.rolling_offset(offset_, Quantile(q), minPeriods_);
+    }
+
+    Series OffsetRolling::min() {
+        POLARS_INSTRUMENT("OffsetRolling::min");
+        return ts_.rolling_offset(offset_, RollingMin(), minPeriods_);
+    }
+
+    Series OffsetRolling::max() {
+        POLARS_INSTRUMENT("OffsetRolling::max");
+        return ts_.rolling_offset(offset_, RollingMax(), minPeriods_);
+    }
+
+    Series OffsetRolling::median() {
+        POLARS_INSTRUMENT("OffsetRolling::median");
+        return ts_.rolling_offset(offset_, Quantile(0.5), minPeriods_);
+    }
+
     Series Window::mean() {
+        POLARS_INSTRUMENT("Window::mean");
         if (win_type_ == WindowProcessor::WindowType::expn) {
             return ts_.rolling(windowSize_, ExpMean(), minPeriods_, center_, symmetric_, win_type_, alpha_);
         } else {
@@ -125,6 +422,7 @@ namespace polars {
     }
 
     Series Window::sum() {
+        POLARS_INSTRUMENT("Window::sum");
         return ts_.rolling(windowSize_, Sum(), minPeriods_, center_, symmetric_, win_type_, alpha_);
     }
 
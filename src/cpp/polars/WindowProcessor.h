@@ -7,10 +7,33 @@
 
 #include "armadillo"
 
+#include <deque>
+#include <memory>
+#include <set>
+
 
 namespace polars {
     class Series;
 
+    /**
+     * Running state of a window aggregate that is updated as values enter and leave a sliding window, so that a
+     * rolling computation costs O(1) per step rather than re-evaluating the whole window.
+     *
+     * Only finite values are passed to add/remove; the caller is responsible for skipping NANs.
+     */
+    class WindowAccumulator {
+    public:
+        virtual ~WindowAccumulator() = default;
+
+        virtual void add(double value) = 0;
+
+        virtual void remove(double value) = 0;
+
+        virtual double value() const = 0;
+
+        virtual void reset() = 0;
+    };
+
     class WindowProcessor {
     public:
 
@@ -23,6 +46,14 @@ namespace polars {
         virtual double processWindow(const Series &window, const arma::vec& weights) const = 0;
 
         virtual double defaultValue() const = 0;
+
+        /**
+         * Processors that can be updated incrementally return a fresh accumulator here. Processors that return
+         * nullptr (the default) are evaluated by calling processWindow on every window.
+         */
+        virtual std::unique_ptr<WindowAccumulator> accumulator() const {
+            return nullptr;
+        }
     };
 
 
@@ -32,6 +63,8 @@ namespace polars {
 
         double processWindow(const Series &window, const arma::vec& weights = {}) const;
 
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
         inline double defaultValue() const {
             return NAN;
         }
@@ -46,6 +79,8 @@ namespace polars {
 
         double processWindow(const Series &window, const arma::vec& weights = {}) const;
 
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
         inline double defaultValue() const {
             return NAN;
         }
@@ -59,6 +94,8 @@ namespace polars {
 
         double processWindow(const Series &window, const arma::vec& weights = {}) const;
 
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
         inline double defaultValue() const {
             return default_value;
         }
@@ -75,6 +112,8 @@ namespace polars {
 
         double processWindow(const Series &window, const arma::vec& weights = {}) const;
 
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
         inline double defaultValue() const {
             return default_value;
         }
@@ -91,6 +130,8 @@ namespace polars {
 
         double processWindow(const Series &window, const arma::vec& weights = {}) const;
 
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
         inline double defaultValue() const {
             return default_value;
         }
@@ -99,6 +140,32 @@ namespace polars {
         double default_value = NAN;
     };
 
+    class RollingMin : public WindowProcessor {
+    public:
+        RollingMin() = default;
+
+        double processWindow(const Series &window, const arma::vec& weights = {}) const;
+
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
+        inline double defaultValue() const {
+            return NAN;
+        }
+    };
+
+    class RollingMax : public WindowProcessor {
+    public:
+        RollingMax() = default;
+
+        double processWindow(const Series &window, const arma::vec& weights = {}) const;
+
+        std::unique_ptr<WindowAccumulator> accumulator() const;
+
+        inline double defaultValue() const {
+            return NAN;
+        }
+    };
+
     class ExpMean : public WindowProcessor {
     public:
         ExpMean() = default;
@@ -113,9 +180,137 @@ namespace polars {
         double default_value = NAN;
     };
 
+    /**
+     * Compensated (Neumaier) running sum, so that values leaving the window do not leave rounding residue behind.
+     */
+    class SumAccumulator : public WindowAccumulator {
+    public:
+        void add(double value);
+
+        void remove(double value);
+
+        double value() const;
+
+        void reset();
+
+    private:
+        void accumulate(double value);
+
+        arma::uword count = 0;
+        double sum = 0;
+        double compensation = 0;
+    };
+
+    class CountAccumulator : public WindowAccumulator {
+    public:
+        void add(double value);
+
+        void remove(double value);
+
+        double value() const;
+
+        void reset();
+
+    private:
+        arma::uword count = 0;
+    };
+
+    class MeanAccumulator : public WindowAccumulator {
+    public:
+        void add(double value);
+
+        void remove(double value);
+
+        double value() const;
+
+        void reset();
+
+    private:
+        SumAccumulator sum;
+        arma::uword count = 0;
+    };
+
+    /**
+     * Welford's online algorithm for the sample (ddof=1) standard deviation, extended to support removal.
+     */
+    class StdAccumulator : public WindowAccumulator {
+    public:
+        void add(double value);
+
+        void remove(double value);
+
+        double value() const;
+
+        void reset();
+
+    private:
+        arma::uword count = 0;
+        double mean = 0;
+        double m2 = 0;
+    };
+
+    /**
+     * Rolling minimum or maximum backed by a monotonic deque of candidate extremes, giving amortised O(1) updates.
+     * Values must be removed in the order they were added, as they are when a window slides.
+     */
+    class ExtremumAccumulator : public WindowAccumulator {
+    public:
+        explicit ExtremumAccumulator(bool maximum);
+
+        void add(double value);
+
+        void remove(double value);
+
+        double value() const;
+
+        void reset();
+
+    private:
+        bool maximum;
+        std::deque<double> candidates;
+    };
+
+    /**
+     * Rolling quantile kept as two balanced ordered sets: `lower` holds the smallest floor(q * (n - 1)) + 1 values, so
+     * the two values either side of the quantile position are the largest of `lower` and the smallest of `upper`.
+     * Each update is O(log w) and the result interpolates exactly as Quantile::processWindow does.
+     */
+    class QuantileAccumulator : public WindowAccumulator {
+    public:
+        explicit QuantileAccumulator(double quantile);
+
+        void add(double value);
+
+        void remove(double value);
+
+        double value() const;
+
+        void reset();
+
+    private:
+        void rebalance();
+
+        double quantile;
+        std::multiset<double> lower;
+        std::multiset<double> upper;
+    };
+
     arma::vec calculate_window_weights(polars::WindowProcessor::WindowType win_type, arma::uword windowSize,
                                        double alpha = -1);
 
+    /**
+     * Position [leftIdx, rightIdx] of a single rolling window within the input, and the matching slice of the weights.
+     */
+    struct WindowBounds {
+        arma::sword leftIdx;
+        arma::sword rightIdx;
+        arma::sword weightLeftIdx;
+        arma::sword weightRightIdx;
+    };
+
+    WindowBounds _window_bounds(arma::uword centerIdx, arma::uword inputSize, arma::uword windowSize,
+                                arma::uword centerOffset, bool symmetric);
+
     arma::vec _ewm_correction(const arma::vec &results, const arma::vec &v0, polars::WindowProcessor::WindowType win_type);
 
     class Rolling {
@@ -151,6 +346,43 @@ namespace polars {
     };
 
 
+    /**
+     * Rolling windows that span a fixed distance of the index rather than a fixed number of values, like pandas'
+     * offset-based windows (e.g. rolling("5min")). The window for each value covers the labels in
+     * (label - offset, label].
+     */
+    class OffsetRolling {
+    public:
+        OffsetRolling(
+                const Series &ts,
+                double offset,
+                arma::uword minPeriods = 1)
+                :
+                ts_(ts),
+                offset_(offset),
+                minPeriods_(minPeriods)
+        {};
+
+        Series count();
+        Series sum();
+        Series mean();
+        Series std();
+        Series quantile(double q);
+        Series min();
+        Series max();
+        Series median();
+    private:
+        const Series &ts_;
+        double offset_;
+        arma::uword minPeriods_;
+    };
+
+
+    /**
+     * Weighted rolling windows. Exponential (expn) windows weight the whole history whatever windowSize is, and
+     * minPeriods 0 means every value of the series. Their mean() runs as ewm's O(n) recursion unless symmetric is
+     * set; symmetric ones, and the other window types, roll each window at O(windowSize) a value.
+     */
     class Window {
     public:
         Window(
@@ -4,9 +4,22 @@
 
 #include "numc.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
 #define EPSILON  (1.0E-150)
 #define VERYSMALL    (1.0E-8)
 
+// Build the reduction kernels for several instruction sets and pick the best one for the CPU at load time (GCC on
+// x86-64 Linux, where function multi-versioning is available); elsewhere they are compiled for the target as usual.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define POLARS_SIMD_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define POLARS_SIMD_DISPATCH
+#endif
+
 namespace polars {
 
     namespace numc {
@@ -73,8 +86,181 @@ namespace polars {
             return arma::regspace(start, step, stop-step);
         }
 
+        namespace {
+
+            // Independent accumulators per reduction, enough to fill an AVX-512 register, so that the loops below
+            // work on whole vectors rather than reassociating a single running total.
+            const arma::uword lanes = 8;
+
+            // False for NANs as well as infinities, without a branch.
+            inline bool is_finite(double x) {
+                return std::fabs(x) <= std::numeric_limits<double>::max();
+            }
+
+#if defined(__GNUC__)
+            // The lanes as one vector, which GCC and Clang compile to a zmm register, two ymm or four xmm depending on
+            // the target - and so on each of the clones - rather than leaving it to the auto-vectoriser.
+            // Selects are written as bit masks, with no helper functions, as passing these vectors by value would
+            // depend on the target's ABI.
+            typedef double lane_doubles __attribute__((vector_size(lanes * sizeof(double))));
+            typedef std::int64_t lane_bits __attribute__((vector_size(lanes * sizeof(double))));
+
+            // Below this magnitude, as bits with the sign cleared, a double is finite: its exponent isn't all ones.
+            const std::int64_t magnitude_bits = 0x7fffffffffffffff;
+            const std::int64_t infinity_bits = 0x7ff0000000000000;
+
+            POLARS_SIMD_DISPATCH
+            void finite_sums(const double *x, arma::uword n, double *counts, double *sums) {
+                const lane_doubles zero = {};
+                const lane_bits one = (lane_bits) (zero + 1.);
+                lane_doubles laneCounts = zero;
+                lane_doubles laneSums = zero;
+                arma::uword i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    lane_doubles value;
+                    std::memcpy(&value, x + i, sizeof(value));
+                    lane_bits finite = ((lane_bits) value & magnitude_bits) < infinity_bits;
+                    laneCounts += (lane_doubles) (one & finite);
+                    laneSums += (lane_doubles) ((lane_bits) value & finite);
+                }
+                std::memcpy(counts, &laneCounts, sizeof(laneCounts));
+                std::memcpy(sums, &laneSums, sizeof(laneSums));
+                for (; i < n; i++) {
+                    bool finite = is_finite(x[i]);
+                    counts[0] += finite;
+                    sums[0] += finite ? x[i] : 0.;
+                }
+            }
+
+            // Welford's update in each lane. A value that isn't finite is swapped for the lane's mean, which leaves the
+            // mean and m2 as they were, and the divisor of a lane that is still empty is 1 rather than 0.
+            POLARS_SIMD_DISPATCH
+            void finite_moments(const double *x, arma::uword n, double *counts, double *means, double *m2s) {
+                const lane_doubles zero = {};
+                const lane_bits one = (lane_bits) (zero + 1.);
+                lane_doubles laneCounts = zero;
+                lane_doubles laneMeans = zero;
+                lane_doubles laneM2s = zero;
+                arma::uword i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    lane_doubles loaded;
+                    std::memcpy(&loaded, x + i, sizeof(loaded));
+                    lane_bits finite = ((lane_bits) loaded & magnitude_bits) < infinity_bits;
+                    lane_bits kept = ((lane_bits) loaded & finite) | ((lane_bits) laneMeans & ~finite);
+                    lane_doubles value = (lane_doubles) kept;
+                    laneCounts += (lane_doubles) (one & finite);
+                    lane_doubles delta = value - laneMeans;
+                    laneMeans += delta / (laneCounts + (lane_doubles) (one & (laneCounts == zero)));
+                    laneM2s += delta * (value - laneMeans);
+                }
+                std::memcpy(counts, &laneCounts, sizeof(laneCounts));
+                std::memcpy(means, &laneMeans, sizeof(laneMeans));
+                std::memcpy(m2s, &laneM2s, sizeof(laneM2s));
+                for (; i < n; i++) {
+                    double value = x[i];
+                    if (is_finite(value)) {
+                        counts[0] += 1;
+                        double delta = value - means[0];
+                        means[0] += delta / counts[0];
+                        m2s[0] += delta * (value - means[0]);
+                    }
+                }
+            }
+#else
+            void finite_sums(const double *x, arma::uword n, double *counts, double *sums) {
+                double laneCounts[lanes] = {};
+                double laneSums[lanes] = {};
+                arma::uword i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    for (arma::uword k = 0; k < lanes; k++) {
+                        double value = x[i + k];
+                        bool finite = is_finite(value);
+                        laneCounts[k] += finite;
+                        laneSums[k] += finite ? value : 0.;
+                    }
+                }
+                for (; i < n; i++) {
+                    bool finite = is_finite(x[i]);
+                    laneCounts[0] += finite;
+                    laneSums[0] += finite ? x[i] : 0.;
+                }
+                std::copy(laneCounts, laneCounts + lanes, counts);
+                std::copy(laneSums, laneSums + lanes, sums);
+            }
+
+            void finite_moments(const double *x, arma::uword n, double *counts, double *means, double *m2s) {
+                double laneCounts[lanes] = {};
+                double laneMeans[lanes] = {};
+                double laneM2s[lanes] = {};
+                arma::uword i = 0;
+                for (; i + lanes <= n; i += lanes) {
+                    for (arma::uword k = 0; k < lanes; k++) {
+                        double value = x[i + k];
+                        bool finite = is_finite(value);
+                        double count = laneCounts[k] + finite;
+                        double delta = value - laneMeans[k];
+                        laneMeans[k] += finite ? delta / count : 0.;
+                        laneM2s[k] += finite ? delta * (value - laneMeans[k]) : 0.;
+                        laneCounts[k] = count;
+                    }
+                }
+                for (; i < n; i++) {
+                    double value = x[i];
+                    if (is_finite(value)) {
+                        laneCounts[0] += 1;
+                        double delta = value - laneMeans[0];
+                        laneMeans[0] += delta / laneCounts[0];
+                        laneM2s[0] += delta * (value - laneMeans[0]);
+                    }
+                }
+                std::copy(laneCounts, laneCounts + lanes, counts);
+                std::copy(laneMeans, laneMeans + lanes, means);
+                std::copy(laneM2s, laneM2s + lanes, m2s);
+            }
+#endif
+
+        }  // namespace
+
+        arma::uword count_finite(const arma::vec &series) {
+            return sum_count_finite(series).count;
+        }
+
+        FiniteSum sum_count_finite(const arma::vec &series) {
+            double counts[lanes] = {};
+            double sums[lanes] = {};
+            finite_sums(series.memptr(), series.n_elem, counts, sums);
+
+            FiniteSum result = {0, 0.};
+            for (arma::uword k = 0; k < lanes; k++) {
+                result.count += counts[k];
+                result.sum += sums[k];
+            }
+            return result;
+        }
+
         double sum_finite(const arma::vec &series){
-            return arma::sum(series.elem(arma::find_finite(series)));
+            return sum_count_finite(series).sum;
+        }
+
+        FiniteMoments moments_finite(const arma::vec &series) {
+            double counts[lanes] = {};
+            double means[lanes] = {};
+            double m2s[lanes] = {};
+            finite_moments(series.memptr(), series.n_elem, counts, means, m2s);
+
+            // Combine the lanes with Chan et al.'s pairwise update.
+            double count = 0;
+            double mean = 0;
+            double m2 = 0;
+            for (arma::uword k = 0; k < lanes; k++) {
+                if (counts[k] == 0) continue;
+                double combined = count + counts[k];
+                double delta = means[k] - mean;
+                mean += delta * counts[k] / combined;
+                m2 += m2s[k] + delta * delta * count * counts[k] / combined;
+                count = combined;
+            }
+            return {(arma::uword) count, mean, m2};
         }
 
 
@@ -24,8 +24,32 @@ namespace polars {
 
         arma::vec arange(double start, double stop, double step = 1.);
 
+        /**
+         * Count and sum of the finite values, NANs and infinities being skipped.
+         */
+        struct FiniteSum {
+            arma::uword count;
+            double sum;
+        };
+
+        /**
+         * Count, mean and sum of squared deviations from the mean (m2) of the finite values.
+         */
+        struct FiniteMoments {
+            arma::uword count;
+            double mean;
+            double m2;
+        };
+
+        // Single pass, allocation-free reductions over the finite values.
+        arma::uword count_finite(const arma::vec &series);
+
+        FiniteSum sum_count_finite(const arma::vec &series);
+
         double sum_finite(const arma::vec &series);
 
+        FiniteMoments moments_finite(const arma::vec &series);
+
         arma::vec triang(int M, bool sym = true);
 
         arma::vec exponential(int M, double tau = 1., bool sym = true, double center=-1.);
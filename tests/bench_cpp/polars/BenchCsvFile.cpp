@@ -0,0 +1,89 @@
+#include "polars/CsvFile.h"
+#include "polars/ThreadPool.h"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+
+namespace CsvFileBenchmarks {
+using namespace polars;
+using TimePoint = time_point<system_clock, milliseconds>;
+
+std::string temp_path(const std::string &name) {
+    const char *dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/polars_bench_" + name + ".csv";
+}
+
+std::size_t file_size(const std::string &path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return static_cast<std::size_t>(file.tellg());
+}
+
+TimeSeries<TimePoint> make_prices(arma::uword n) {
+    std::vector<TimePoint> timestamps(n);
+    arma::vec prices(n);
+    for (arma::uword i = 0; i < n; i++) {
+        timestamps[i] = TimePoint(milliseconds(1500000000000 + 250 * i));
+        // Full precision decimals, as parsing those is the expensive case.
+        prices[i] = 100 + 3 * std::sin(i * 0.001);
+    }
+    return TimeSeries<TimePoint>(prices, timestamps);
+}
+
+void sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+}
+
+void BM_read_csv(benchmark::State &state) {
+    std::string path = temp_path("read");
+    write_csv(path, static_cast<const Series &>(make_prices(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read_csv(path));
+    }
+    state.SetBytesProcessed(state.iterations() * file_size(path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_read_csv)->Apply(sizes);
+
+void BM_read_csv_parallel(benchmark::State &state) {
+    std::string path = temp_path("read_parallel");
+    write_csv(path, static_cast<const Series &>(make_prices(state.range(0))));
+    CsvOptions options;
+    options.pool = &ThreadPool::global();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read_csv(path, options));
+    }
+    state.SetBytesProcessed(state.iterations() * file_size(path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_read_csv_parallel)->Apply(sizes);
+
+void BM_read_csv_iso8601(benchmark::State &state) {
+    std::string path = temp_path("read_iso8601");
+    write_csv(path, make_prices(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read_csv_timeseries<TimePoint>(path));
+    }
+    state.SetBytesProcessed(state.iterations() * file_size(path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_read_csv_iso8601)->Apply(sizes);
+
+void BM_write_csv_iso8601(benchmark::State &state) {
+    std::string path = temp_path("write_iso8601");
+    TimeSeries<TimePoint> ts = make_prices(state.range(0));
+    for (auto _ : state) {
+        write_csv(path, ts);
+    }
+    state.SetBytesProcessed(state.iterations() * file_size(path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_write_csv_iso8601)->Apply(sizes);
+
+}  // CsvFileBenchmarks
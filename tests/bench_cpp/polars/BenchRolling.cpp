@@ -0,0 +1,109 @@
+#include "polars/Series.h"
+
+#include "polars/ThreadPool.h"
+#include "polars/WindowProcessor.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+
+
+namespace RollingBenchmarks {
+using namespace polars;
+
+Series make_series(arma::uword n) {
+    arma::vec values = arma::linspace(0, 1000, n);
+    values.transform([](double val) { return std::sin(val); });
+    for (arma::uword i = 0; i < n; i += 100) {
+        values[i] = NAN;
+    }
+    return Series(values, arma::linspace(0, n - 1, n));
+}
+
+// (series size, window size)
+void sizes_and_windows(benchmark::internal::Benchmark *b) {
+    for (long n : {1000, 100000, 10000000}) {
+        for (long window : {10, 100, 1000}) {
+            b->Args({n, window});
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+#define POLARS_ROLLING_BENCHMARK(aggregate)                                                                            \
+    void BM_rolling_##aggregate(benchmark::State &state) {                                                             \
+        Series a = make_series(state.range(0));                                                                        \
+        for (auto _ : state) {                                                                                         \
+            benchmark::DoNotOptimize(a.rolling(state.range(1), 1).aggregate());                                        \
+        }                                                                                                              \
+        state.SetItemsProcessed(state.iterations() * state.range(0));                                                  \
+    }                                                                                                                  \
+    BENCHMARK(BM_rolling_##aggregate)->Apply(sizes_and_windows);
+
+POLARS_ROLLING_BENCHMARK(count)
+POLARS_ROLLING_BENCHMARK(sum)
+POLARS_ROLLING_BENCHMARK(mean)
+POLARS_ROLLING_BENCHMARK(std)
+POLARS_ROLLING_BENCHMARK(min)
+POLARS_ROLLING_BENCHMARK(max)
+POLARS_ROLLING_BENCHMARK(median)
+
+#undef POLARS_ROLLING_BENCHMARK
+
+void BM_rolling_quantile(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.rolling(state.range(1), 1).quantile(0.9));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rolling_quantile)->Apply(sizes_and_windows);
+
+void BM_rolling_mean_parallel(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.rolling(state.range(1), Mean(), 1, true, false,
+                                           WindowProcessor::WindowType::none, -1, &ThreadPool::global()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rolling_mean_parallel)->Apply(sizes_and_windows);
+
+// Weighted windows evaluate every window in full, so stop at 1e6 values.
+void weighted_sizes_and_windows(benchmark::internal::Benchmark *b) {
+    for (long n : {1000, 100000, 1000000}) {
+        for (long window : {10, 100}) {
+            b->Args({n, window});
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+void BM_window_triang_mean(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.rolling(state.range(1), 1, true, false, WindowProcessor::WindowType::triang).mean());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_window_triang_mean)->Apply(weighted_sizes_and_windows);
+
+void BM_window_ewm_mean(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.rolling(10, 1, false, false, WindowProcessor::WindowType::expn, 0.1).mean());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_window_ewm_mean)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+void BM_ewm_std(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.ewm(Decay::span(20)).std());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ewm_std)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+}  // RollingBenchmarks
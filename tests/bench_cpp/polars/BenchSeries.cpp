@@ -0,0 +1,182 @@
+#include "polars/Series.h"
+
+#include "polars/Instrumentation.h"
+#include "polars/SeriesMask.h"
+#include "polars/numc.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+
+
+namespace SeriesBenchmarks {
+using namespace polars;
+
+// Series of n values, with a NAN every 100, on a sorted unit-spaced index.
+Series make_series(arma::uword n, double seed = 1) {
+    arma::vec values = arma::linspace(seed, seed + 1000, n);
+    values.transform([](double val) { return std::sin(val); });
+    for (arma::uword i = 0; i < n; i += 100) {
+        values[i] = NAN;
+    }
+    return Series(values, arma::linspace(0, n - 1, n));
+}
+
+void sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+}
+
+// Reports the heap allocations and bytes per iteration made on this thread since construction, as "allocs" and
+// "bytes" counters. Allocations are only counted with POLARS_INSTRUMENTATION on; otherwise this does nothing.
+class AllocationCounters {
+public:
+#ifdef POLARS_INSTRUMENTATION
+    AllocationCounters() : start(instrumentation::thread_allocations()) {}
+
+    void report(benchmark::State &state) const {
+        instrumentation::AllocationCount end = instrumentation::thread_allocations();
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(end.allocations - start.allocations),
+                                                      benchmark::Counter::kAvgIterations);
+        state.counters["bytes"] = benchmark::Counter(static_cast<double>(end.bytes - start.bytes),
+                                                     benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    instrumentation::AllocationCount start;
+#else
+    void report(benchmark::State &) const {}
+#endif
+};
+
+void BM_arithmetic(benchmark::State &state) {
+    Series a = make_series(state.range(0), 1);
+    Series b = make_series(state.range(0), 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((a - b) * 2.0 + a);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_arithmetic)->Apply(sizes);
+
+void BM_arithmetic_unaligned(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    Series b(a.values(), a.index() + 0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a + b);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_arithmetic_unaligned)->Apply(sizes);
+
+void BM_comparison(benchmark::State &state) {
+    Series a = make_series(state.range(0), 1);
+    Series b = make_series(state.range(0), 2);
+    AllocationCounters allocations;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a > b);
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_comparison)->Apply(sizes);
+
+void BM_diff(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    AllocationCounters allocations;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.diff());
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_diff)->Apply(sizes);
+
+void BM_iloc_range(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    int n = state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.iloc(n / 4, 3 * n / 4));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(BM_iloc_range)->Apply(sizes);
+
+void BM_loc_labels(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    arma::vec labels = arma::regspace(0, 10, state.range(0) - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.loc(labels));
+    }
+    state.SetItemsProcessed(state.iterations() * labels.n_elem);
+}
+BENCHMARK(BM_loc_labels)->Apply(sizes);
+
+void BM_where(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    SeriesMask condition = a > 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.where(condition));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_where)->Apply(sizes);
+
+void BM_to_map(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    AllocationCounters allocations;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.to_map());
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_to_map)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+// Reductions: the single-pass numc kernels against the Armadillo expression they replaced.
+void BM_mean(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.mean());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_mean)->Apply(sizes);
+
+void BM_mean_armadillo(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arma::mean(a.values().elem(arma::find_finite(a.values()))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_mean_armadillo)->Apply(sizes);
+
+void BM_std(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.std());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std)->Apply(sizes);
+
+void BM_std_armadillo(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arma::stddev(a.values().elem(arma::find_finite(a.values()))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std_armadillo)->Apply(sizes);
+
+void BM_numc_quantile(benchmark::State &state) {
+    Series a = make_series(state.range(0));
+    arma::vec values = a.dropna().values();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(numc::quantile(values, 0.3));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_numc_quantile)->Apply(sizes);
+
+}  // SeriesBenchmarks
@@ -0,0 +1,71 @@
+#include "polars/TimeSeries.h"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <vector>
+
+
+namespace TimeSeriesBenchmarks {
+using namespace polars;
+using TimePoint = time_point<system_clock, milliseconds>;
+
+std::vector<TimePoint> make_timestamps(arma::uword n) {
+    std::vector<TimePoint> timestamps(n);
+    for (arma::uword i = 0; i < n; i++) {
+        timestamps[i] = TimePoint(milliseconds(1500000000000 + 250 * i));
+    }
+    return timestamps;
+}
+
+void sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+}
+
+void BM_timeseries_from_timestamps(benchmark::State &state) {
+    std::vector<TimePoint> timestamps = make_timestamps(state.range(0));
+    arma::vec values = arma::linspace(0, 1, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TimeSeries<TimePoint>(values, timestamps));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_timeseries_from_timestamps)->Apply(sizes);
+
+void BM_timeseries_timestamps(benchmark::State &state) {
+    TimeSeries<TimePoint> ts(arma::linspace(0, 1, state.range(0)), make_timestamps(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::vector<TimePoint>(ts.timestamps()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_timeseries_timestamps)->Apply(sizes);
+
+void BM_timeseries_head(benchmark::State &state) {
+    TimeSeries<TimePoint> ts(arma::linspace(0, 1, state.range(0)), make_timestamps(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ts.head(state.range(0) / 2));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(BM_timeseries_head)->Apply(sizes);
+
+void BM_timeseries_to_map(benchmark::State &state) {
+    TimeSeries<TimePoint> ts(arma::linspace(0, 1, state.range(0)), make_timestamps(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ts.to_timeseries_map());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_timeseries_to_map)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+void BM_timeseries_rolling_offset(benchmark::State &state) {
+    TimeSeries<TimePoint> ts(arma::linspace(0, 1, state.range(0)), make_timestamps(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ts.rolling(seconds(10)).mean());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_timeseries_rolling_offset)->Apply(sizes);
+
+}  // TimeSeriesBenchmarks
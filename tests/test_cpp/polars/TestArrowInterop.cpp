@@ -0,0 +1,215 @@
+#include "polars/ArrowInterop.h"
+
+#include "polars/DataFrame.h"
+#include "polars/numc.h"
+#include "polars/Series.h"
+#include "polars/SeriesMask.h"
+#include "polars/TimeSeries.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+
+namespace ArrowInteropTests {
+using namespace polars;
+
+int arrays_released = 0;
+
+void release_array(ArrowArray *array) {
+    for (int64_t i = 0; i < array->n_children; i++) {
+        if (array->children[i]->release) {
+            array->children[i]->release(array->children[i]);
+        }
+    }
+    arrays_released += array->n_children > 0;
+    array->release = nullptr;
+}
+
+void release_schema(ArrowSchema *schema) {
+    for (int64_t i = 0; i < schema->n_children; i++) {
+        if (schema->children[i]->release) {
+            schema->children[i]->release(schema->children[i]);
+        }
+    }
+    schema->release = nullptr;
+}
+
+ArrowSchema make_schema(const char *format, const char *name) {
+    return {format, name, nullptr, 0, 0, nullptr, nullptr, release_schema, nullptr};
+}
+
+ArrowArray make_array(int64_t length, int64_t null_count, int64_t offset, const void **buffers) {
+    return {length, null_count, offset, 2, 0, buffers, nullptr, nullptr, release_array, nullptr};
+}
+
+// A struct array of an int64 index and float64 values with nulls, as another producer might hand over.
+struct Batch {
+    std::vector<int64_t> index = {10, 20, 30, 40, 50};
+    std::vector<double> values = {0, 1.5, -1, 2.5, 4};
+    std::vector<uint8_t> validity = {0x1b};  // all but the third value, 0b11011
+    const void *indexBuffers[2] = {nullptr, index.data()};
+    const void *valueBuffers[2] = {validity.data(), values.data()};
+
+    ArrowArray children[2] = {make_array(5, 0, 0, indexBuffers), make_array(5, 1, 0, valueBuffers)};
+    ArrowArray *childPointers[2] = {&children[0], &children[1]};
+    const void *structBuffers[1] = {nullptr};
+    ArrowArray array = {4, 0, 1, 1, 2, structBuffers, childPointers, nullptr, release_array, nullptr};
+
+    ArrowSchema childSchemas[2] = {make_schema("l", "index"), make_schema("g", "value")};
+    ArrowSchema *childSchemaPointers[2] = {&childSchemas[0], &childSchemas[1]};
+    ArrowSchema schema = {"+s", "", nullptr, 0, 2, childSchemaPointers, nullptr, release_schema, nullptr};
+};
+
+TEST(ArrowInterop, import) {
+    arrays_released = 0;
+    Batch batch;
+    {
+        Series imported = import_arrow(&batch.array, &batch.schema);
+        EXPECT_EQ(batch.array.release, nullptr) << "Expect " << "the array to have been moved";
+        EXPECT_EQ(batch.schema.release, nullptr);
+        EXPECT_PRED2(Series::equal, imported, Series({1.5, NAN, 2.5, 4}, {20, 30, 40, 50}))
+                            << "Expect " << "the struct's offset to apply and nulls to become NAN";
+        EXPECT_TRUE(imported.shared_index().is_sorted());
+        EXPECT_EQ(arrays_released, 0) << "Expect " << "the array to be kept until the Series has gone";
+    }
+    EXPECT_EQ(arrays_released, 1);
+
+    Batch masked;
+    SeriesMask valid;
+    {
+        Series imported = import_arrow(&masked.array, &masked.schema, &valid);
+        EXPECT_PRED2(SeriesMask::equal, valid, SeriesMask({1, 0, 1, 1}, {20, 30, 40, 50}));
+        EXPECT_EQ(imported.values().memptr(), masked.values.data() + 1)
+                            << "Expect " << "values with nulls to be wrapped when the validity is asked for";
+        EXPECT_EQ(imported.values()[1], -1);
+    }
+    EXPECT_EQ(arrays_released, 1) << "Expect " << "the mask to keep the array too, as it shares the index";
+    valid = SeriesMask();
+    EXPECT_EQ(arrays_released, 2);
+}
+
+TEST(ArrowInterop, round_trip) {
+    Series input(arma::linspace(0, 1, 100), arma::linspace(1, 100, 100));
+    Series moved = input;
+    const double *values = moved.values().memptr();
+    const double *index = moved.index().memptr();
+
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(std::move(moved), &array, &schema);
+    ASSERT_EQ(schema.n_children, 2);
+    EXPECT_STREQ(schema.format, "+s");
+    EXPECT_STREQ(schema.children[0]->name, "index");
+    EXPECT_STREQ(schema.children[1]->format, "g");
+    EXPECT_EQ(array.length, 100);
+    EXPECT_EQ(array.children[0]->buffers[1], index) << "Expect " << "the index to be exported without copying";
+    EXPECT_EQ(array.children[1]->buffers[1], values) << "Expect " << "the values to be exported without copying";
+
+    Series imported = import_arrow(&array, &schema);
+    EXPECT_PRED2(Series::equal, imported, input);
+    EXPECT_EQ(imported.values().memptr(), values) << "Expect " << "the values to be imported without copying";
+
+    // Consumers may move a child out and release it separately from the struct.
+    Series other(arma::vec({1, 2}), arma::vec({3, 4}));
+    export_arrow(other, &array, &schema);
+    ArrowArray child = *array.children[1];
+    array.children[1]->release = nullptr;
+    array.release(&array);
+    schema.release(&schema);
+    EXPECT_EQ(static_cast<const double *>(child.buffers[1])[1], 2);
+    child.release(&child);
+    EXPECT_EQ(child.release, nullptr);
+}
+
+TEST(ArrowInterop, dataframe) {
+    DataFrame df({"a", "b"}, {Series({1, 2, 3}, {1, 2, 3}), Series({4, NAN, 6}, {1, 2, 3})});
+
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(df, &array, &schema);
+    ASSERT_EQ(schema.n_children, 3);
+    EXPECT_STREQ(schema.children[2]->name, "b");
+
+    DataFrame imported = import_arrow_dataframe(&array, &schema);
+    EXPECT_PRED2(DataFrame::equal, imported, df);
+    EXPECT_TRUE(imported["a"].shared_index().shares_memory_with(imported["b"].shared_index()));
+}
+
+TEST(ArrowInterop, timeseries) {
+    using namespace std::chrono;
+    using TimePoint = time_point<system_clock, milliseconds>;
+    using SecondsTimePoint = time_point<system_clock, seconds>;
+
+    TimeSeries<TimePoint> ts({1, 2, 3}, {TimePoint(milliseconds(-500)), TimePoint(milliseconds(1500)),
+                                         TimePoint(milliseconds(3000))});
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(ts, &array, &schema);
+    EXPECT_STREQ(schema.children[0]->format, "tsm:UTC");
+    EXPECT_EQ(static_cast<const int64_t *>(array.children[0]->buffers[1])[1], 1500);
+
+    TimeSeries<SecondsTimePoint> seconds = import_arrow_timeseries<SecondsTimePoint>(&array, &schema);
+    EXPECT_PRED2(numc::equal_handling_nans, seconds.index(), arma::vec({-1, 1, 3}))
+                        << "Expect " << "timestamps to be converted to the time point's ticks, rounding down";
+
+    export_arrow(TimeSeries<time_point<system_clock, minutes>>({1}, {time_point<system_clock, minutes>(minutes(2))}),
+                 &array, &schema);
+    EXPECT_STREQ(schema.children[0]->format, "tss:UTC");
+    EXPECT_EQ(static_cast<const int64_t *>(array.children[0]->buffers[1])[0], 120);
+    array.release(&array);
+    schema.release(&schema);
+}
+
+TEST(ArrowInterop, nanosecond_timeseries) {
+    using namespace std::chrono;
+    using TimePoint = time_point<system_clock, nanoseconds>;
+    using SecondsTimePoint = time_point<system_clock, seconds>;
+
+    // 19 digit epochs, beyond the 2^53 ticks a double holds exactly.
+    std::vector<TimePoint> timestamps = {TimePoint(nanoseconds(1700000000123456789)),
+                                         TimePoint(nanoseconds(1700000000123456790))};
+    ArrowArray array;
+    ArrowSchema schema;
+    export_arrow(TimeSeries<TimePoint>({1, 2}, timestamps), &array, &schema);
+    EXPECT_STREQ(schema.children[0]->format, "tsn:UTC");
+    const int64_t *exported = static_cast<const int64_t *>(array.children[0]->buffers[1]);
+    EXPECT_EQ(exported[0], 1700000000123456789) << "Expect " << "the exact ticks to be exported";
+
+    TimeSeries<TimePoint> imported = import_arrow_timeseries<TimePoint>(&array, &schema);
+    EXPECT_EQ(imported.timestamps(), timestamps);
+    EXPECT_EQ(imported.shared_index().ticks(), exported)
+                        << "Expect " << "timestamps in the time point's unit to be imported without copying";
+
+    auto missing = TimeSeries<TimePoint>::from_series(Series({1, 2}, {0, NAN}));
+    EXPECT_THROW(export_arrow(missing, &array, &schema), std::invalid_argument)
+                        << "Expect " << "a NAN timestamp to be rejected";
+
+    export_arrow(TimeSeries<SecondsTimePoint>({1}, {SecondsTimePoint(seconds(100000000000))}), &array, &schema);
+    EXPECT_THROW(import_arrow_timeseries<TimePoint>(&array, &schema), std::invalid_argument)
+                        << "Expect " << "seconds that overflow int64 nanoseconds to be rejected";
+}
+
+TEST(ArrowInterop, errors) {
+    arrays_released = 0;
+    Batch batch;
+    batch.schema.format = "+l";
+    EXPECT_THROW(import_arrow(&batch.array, &batch.schema), std::invalid_argument);
+    EXPECT_EQ(arrays_released, 1) << "Expect " << "the array to be released even though it was rejected";
+    EXPECT_THROW(import_arrow(&batch.array, &batch.schema), std::invalid_argument)
+                        << "Expect " << "a released array to be rejected";
+
+    Batch strings;
+    strings.childSchemas[1].format = "u";
+    EXPECT_THROW(import_arrow(&strings.array, &strings.schema), std::invalid_argument);
+
+    Batch nullIndex;
+    nullIndex.indexBuffers[0] = nullIndex.validity.data();
+    nullIndex.children[0].null_count = 1;
+    EXPECT_THROW(import_arrow(&nullIndex.array, &nullIndex.schema), std::invalid_argument);
+}
+
+}  // ArrowInteropTests
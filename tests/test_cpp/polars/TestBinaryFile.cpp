@@ -0,0 +1,135 @@
+#include "polars/BinaryFile.h"
+
+#include "polars/Series.h"
+#include "polars/SeriesMask.h"
+#include "polars/TimeSeries.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace BinaryFileTests {
+using namespace polars;
+
+std::string temp_path(const std::string &name) {
+    const char *dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/polars_" + name + ".bin";
+}
+
+TEST(BinaryFile, round_trip) {
+    std::string path = temp_path("round_trip");
+    Series input({1, NAN, 3, -4.5, 5}, {10, 20, 30, 40, 50});
+    write_binary(path, input);
+
+    Series mapped = map_binary(path);
+    EXPECT_PRED2(Series::equal, mapped, input) << "Expect " << "the Series back unchanged";
+    EXPECT_TRUE(mapped.shared_index().is_sorted()) << "Expect " << "sortedness to be read from the header";
+
+    // Both blocks lie in one mapping, 64 byte aligned, rather than in separately allocated copies.
+    auto index = reinterpret_cast<std::uintptr_t>(mapped.index().memptr());
+    auto values = reinterpret_cast<std::uintptr_t>(mapped.values().memptr());
+    EXPECT_EQ(index % 64, 0);
+    EXPECT_EQ(values - index, 64) << "Expect " << "the values block straight after the aligned index block";
+
+    Series unsorted({1, 2, 3}, {3, 1, 2});
+    write_binary(path, unsorted);
+    Series mapped_unsorted = map_binary(path);
+    EXPECT_FALSE(mapped_unsorted.shared_index().is_sorted());
+    EXPECT_PRED2(Series::equal, mapped_unsorted.loc(arma::vec({1, 3})), Series({2, 1}, {1, 3}));
+
+    write_binary(path, Series());
+    EXPECT_PRED2(Series::equal, map_binary(path), Series()) << "Expect " << "an empty Series to round trip";
+
+    std::remove(path.c_str());
+}
+
+TEST(BinaryFile, lifetime) {
+    std::string path = temp_path("lifetime");
+    write_binary(path, Series({1, -2, 3}, {1, 2, 3}));
+
+    SeriesMask positive;
+    {
+        Series mapped = map_binary(path);
+        positive = mapped > 0;
+    }
+    EXPECT_PRED2(SeriesMask::equal, positive, SeriesMask({1, 0, 1}, {1, 2, 3}))
+                        << "Expect " << "the mapping to stay open while its index is in use";
+
+    std::remove(path.c_str());
+}
+
+TEST(BinaryFile, timeseries) {
+    using namespace std::chrono;
+    using TimePoint = time_point<system_clock, milliseconds>;
+
+    std::string path = temp_path("timeseries");
+    std::vector<TimePoint> timestamps = {TimePoint(milliseconds(1000)), TimePoint(milliseconds(2500))};
+    TimeSeries<TimePoint> input({1, 2}, timestamps);
+    write_binary(path, input);
+
+    TimeSeries<TimePoint> mapped = map_binary_timeseries<TimePoint>(path);
+    EXPECT_PRED2(Series::equal, mapped, input);
+    EXPECT_EQ(mapped.timestamps(), timestamps);
+
+    using SecondsTimePoint = time_point<system_clock, seconds>;
+    EXPECT_THROW(map_binary_timeseries<SecondsTimePoint>(path), std::invalid_argument)
+                        << "Expect " << "a different tick period to be rejected";
+    EXPECT_THROW(map_binary(path), std::invalid_argument) << "Expect " << "a time index not to be read as labels";
+
+    // 19 digit nanosecond epochs, beyond the 2^53 ticks a double holds exactly.
+    using NanosTimePoint = time_point<system_clock, nanoseconds>;
+    std::vector<NanosTimePoint> nanos = {NanosTimePoint(nanoseconds(1700000000123456789)),
+                                         NanosTimePoint(nanoseconds(1700000000123456790))};
+    write_binary(path, TimeSeries<NanosTimePoint>({1, 2}, nanos));
+    EXPECT_EQ(map_binary_timeseries<NanosTimePoint>(path).timestamps(), nanos)
+                        << "Expect " << "the time points to be written and mapped back exactly";
+
+    std::remove(path.c_str());
+}
+
+TEST(BinaryFile, version_1) {
+    std::string path = temp_path("version_1");
+    Series input({1, 2, 3}, {1, 2, 3});
+    write_binary(path, input);
+    {
+        // Version 1 headers had a reserved zero where the index dtype now is.
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint32_t version = 1, reserved = 0;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        file.seekp(28);
+        file.write(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+    }
+    EXPECT_PRED2(Series::equal, map_binary(path), input) << "Expect " << "version 1 files to still be mapped";
+
+    std::remove(path.c_str());
+}
+
+TEST(BinaryFile, errors) {
+    std::string path = temp_path("errors");
+    EXPECT_THROW(map_binary(path + ".missing"), std::runtime_error);
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << std::string(200, 'x');
+    }
+    EXPECT_THROW(map_binary(path), std::runtime_error) << "Expect " << "a file without the magic to be rejected";
+
+    write_binary(path, Series({1, 2, 3}, {1, 2, 3}));
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << contents.substr(0, contents.size() - 8);
+    }
+    EXPECT_THROW(map_binary(path), std::runtime_error) << "Expect " << "a truncated file to be rejected";
+
+    std::remove(path.c_str());
+}
+
+}  // BinaryFileTests
@@ -0,0 +1,226 @@
+#include "polars/CsvFile.h"
+
+#include "polars/numc.h"
+#include "polars/Series.h"
+#include "polars/ThreadPool.h"
+#include "polars/TimeSeries.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace CsvFileTests {
+using namespace polars;
+
+std::string temp_path(const std::string &name) {
+    const char *dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/polars_" + name + ".csv";
+}
+
+void write_text(const std::string &path, const std::string &text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+std::string read_text(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+double parse(const std::string &text) {
+    return csv::parse_double(text.data(), text.data() + text.size());
+}
+
+TEST(CsvFile, parse_double) {
+    EXPECT_EQ(parse("0"), 0);
+    EXPECT_EQ(parse("-12.5"), -12.5);
+    EXPECT_EQ(parse(" +3 "), 3) << "Expect " << "surrounding spaces to be ignored";
+    EXPECT_EQ(parse(".25"), 0.25);
+    EXPECT_EQ(parse("1e3"), 1000);
+    EXPECT_EQ(parse("2.5E-3"), 0.0025);
+    EXPECT_EQ(parse("-inf"), -INFINITY);
+    EXPECT_EQ(parse("Infinity"), INFINITY);
+    EXPECT_TRUE(std::isnan(parse("NaN")));
+    EXPECT_TRUE(std::isnan(parse(""))) << "Expect " << "an empty field to be missing";
+
+    // Every result should be the nearest double, as strtod gives, whether on the fast path or not.
+    for (const char *text : {"0.1", "0.3", "123456.789", "1.7976931348623157e308", "4.9e-324", "9007199254740993",
+                             "0.1000000000000000055511151231257827", "1e23", "2.2250738585072014e-308",
+                             "3.14159265358979323846264338327950288"}) {
+        EXPECT_EQ(parse(text), std::strtod(text, nullptr)) << "Expect " << text << " to be parsed exactly";
+    }
+
+    EXPECT_THROW(parse("1.2.3"), std::invalid_argument);
+    EXPECT_THROW(parse("abc"), std::invalid_argument);
+    EXPECT_THROW(parse("1e"), std::invalid_argument);
+    EXPECT_THROW(parse("-"), std::invalid_argument);
+}
+
+TEST(CsvFile, round_trip) {
+    std::string path = temp_path("round_trip");
+    Series input({0.1, NAN, -3, 1e-300, INFINITY, 1. / 3}, {3, 1, 2, 2.5, 10, 1e17});
+    write_csv(path, input);
+    EXPECT_EQ(read_text(path).substr(0, 18), "index,value\n3,0.1\n");
+
+    Series read = read_csv(path);
+    EXPECT_PRED2(Series::equal, read, input) << "Expect " << "values and file order to be kept exactly";
+    EXPECT_FALSE(read.shared_index().is_sorted());
+
+    CsvOptions options;
+    options.header = false;
+    options.delimiter = ';';
+    write_csv(path, Series(), options);
+    EXPECT_PRED2(Series::equal, read_csv(path, options), Series());
+
+    std::remove(path.c_str());
+}
+
+TEST(CsvFile, options) {
+    std::string path = temp_path("options");
+    write_text(path, "id\tname\tprice\tsize\r\n"
+                     "1\ta\t10.5\t3\r\n"
+                     "\r\n"
+                     "2\tb\t\t4\r\n"
+                     "3\tc\t12");
+
+    CsvOptions options;
+    options.delimiter = '\t';
+    options.indexColumn = 0;
+    options.valueColumn = 2;
+    EXPECT_PRED2(Series::equal, read_csv(path, options), Series({10.5, NAN, 12}, {1, 2, 3}))
+                        << "Expect " << "blank lines to be skipped and a missing trailing newline to be fine";
+
+    options.indexColumn = 3;
+    options.valueColumn = 0;
+    EXPECT_THROW(read_csv(path, options), std::invalid_argument) << "Expect " << "a short row to be rejected";
+
+    std::remove(path.c_str());
+}
+
+TEST(CsvFile, errors) {
+    std::string path = temp_path("errors");
+    EXPECT_THROW(read_csv(path + ".missing"), std::runtime_error);
+
+    write_text(path, "index,value\n1,2\n2,3\n3,oops\n4,5\n");
+    try {
+        read_csv(path);
+        FAIL() << "Expect " << "a bad number to be rejected";
+    } catch (const std::invalid_argument &e) {
+        EXPECT_NE(std::string(e.what()).find("line 4"), std::string::npos) << e.what();
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(CsvFile, timeseries) {
+    using namespace std::chrono;
+    using TimePoint = time_point<system_clock, milliseconds>;
+    std::string path = temp_path("timeseries");
+
+    write_text(path, "timestamp,value\n"
+                     "2020-01-02T03:04:05.678Z,1\n"
+                     "2020-01-02 03:04:06,2\n"
+                     "2020-01-02T05:04:07+02:00,3\n"
+                     "2020-01-02,4\n"
+                     "1577934248.5,5\n");
+    TimeSeries<TimePoint> ts = read_csv_timeseries<TimePoint>(path);
+
+    std::int64_t day = 1577923200000;  // 2020-01-02T00:00:00Z in milliseconds
+    std::int64_t time = day + ((3 * 60 + 4) * 60 + 5) * 1000;
+    std::vector<TimePoint> expected = {TimePoint(milliseconds(time + 678)), TimePoint(milliseconds(time + 1000)),
+                                       TimePoint(milliseconds(time + 2000)), TimePoint(milliseconds(day)),
+                                       TimePoint(milliseconds(time + 3500))};
+    EXPECT_EQ(ts.timestamps(), expected);
+    EXPECT_PRED2(numc::equal_handling_nans, ts.values(), arma::vec({1, 2, 3, 4, 5}));
+
+    write_csv(path, ts);
+    EXPECT_EQ(read_text(path).substr(0, 45), "timestamp,value\n2020-01-02T03:04:05.678,1\n202")
+                        << "Expect " << "timestamps to be written as ISO 8601 with milliseconds";
+    EXPECT_PRED2(Series::equal, read_csv_timeseries<TimePoint>(path), ts);
+
+    CsvOptions options;
+    options.writeIso8601 = false;
+    options.epochUnit = CsvOptions::EpochUnit::milliseconds;
+    write_csv(path, ts, options);
+    EXPECT_PRED2(Series::equal, read_csv_timeseries<TimePoint>(path, options), ts);
+
+    // Rounding down into a coarser time point, including before the epoch.
+    write_text(path, "timestamp,value\n1969-12-31T23:59:59.5,1\n-0.5,2\n");
+    auto seconds = read_csv_timeseries<time_point<system_clock, std::chrono::seconds>>(path);
+    EXPECT_PRED2(numc::equal_handling_nans, seconds.index(), arma::vec({-1, -1}));
+
+    write_text(path, "timestamp,value\n2020-13-01,1\n");
+    EXPECT_THROW(read_csv_timeseries<TimePoint>(path), std::invalid_argument);
+
+    write_text(path, "unchanged");
+    auto missing = TimeSeries<TimePoint>::from_series(Series({1, 2, 3}, {0, NAN, 2}));
+    EXPECT_THROW(write_csv(path, missing), std::invalid_argument) << "Expect " << "a NAN timestamp to be rejected";
+    EXPECT_THROW(write_csv(path, missing, options), std::invalid_argument);
+    auto huge = TimeSeries<TimePoint>::from_series(Series({1}, {1e19}));
+    EXPECT_THROW(write_csv(path, huge, options), std::invalid_argument)
+                        << "Expect " << "a timestamp beyond int64 to be rejected";
+    EXPECT_EQ(read_text(path), "unchanged") << "Expect " << "the file to be left as it was";
+
+    std::remove(path.c_str());
+}
+
+TEST(CsvFile, nanosecond_timeseries) {
+    using namespace std::chrono;
+    using TimePoint = time_point<system_clock, nanoseconds>;
+    std::string path = temp_path("nanosecond_timeseries");
+
+    // 19 digit epochs, beyond the 2^53 ticks a double holds exactly.
+    CsvOptions options;
+    options.epochUnit = CsvOptions::EpochUnit::nanoseconds;
+    write_text(path, "timestamp,value\n"
+                     "2023-11-14T22:13:20.123456789Z,1\n"
+                     "1700000000123456790,2\n");
+    std::vector<TimePoint> expected = {TimePoint(nanoseconds(1700000000123456789)),
+                                       TimePoint(nanoseconds(1700000000123456790))};
+    EXPECT_EQ(read_csv_timeseries<TimePoint>(path, options).timestamps(), expected)
+                        << "Expect " << "nanosecond timestamps to be read exactly";
+
+    TimeSeries<TimePoint> ts({1, 2}, expected);
+    write_csv(path, ts);
+    EXPECT_EQ(read_text(path), "timestamp,value\n2023-11-14T22:13:20.123456789,1\n2023-11-14T22:13:20.123456790,2\n");
+    EXPECT_EQ(read_csv_timeseries<TimePoint>(path).timestamps(), expected);
+
+    options.writeIso8601 = false;
+    write_csv(path, ts, options);
+    EXPECT_EQ(read_text(path), "timestamp,value\n1700000000123456789,1\n1700000000123456790,2\n");
+    EXPECT_EQ(read_csv_timeseries<TimePoint>(path, options).timestamps(), expected);
+
+    options.epochUnit = CsvOptions::EpochUnit::seconds;
+    EXPECT_THROW(read_csv_timeseries<TimePoint>(path, options), std::invalid_argument)
+                        << "Expect " << "seconds that overflow int64 nanoseconds to be rejected";
+    write_text(path, "timestamp,value\n99999999999999999999,1\n");
+    EXPECT_THROW(read_csv_timeseries<TimePoint>(path, options), std::invalid_argument);
+
+    std::remove(path.c_str());
+}
+
+TEST(CsvFile, parallel) {
+    std::string path = temp_path("parallel");
+    arma::uword n = 100000;
+    Series input(arma::linspace(0, 1, n) * 1e3 + 0.001, arma::linspace(1, n, n));
+    write_csv(path, input);
+
+    ThreadPool pool(4);
+    CsvOptions options;
+    options.pool = &pool;
+    Series read = read_csv(path, options);
+    EXPECT_PRED2(Series::equal, read, input) << "Expect " << "the same rows in the same order as reading serially";
+    EXPECT_TRUE(read.shared_index().is_sorted());
+
+    std::remove(path.c_str());
+}
+
+}  // CsvFileTests
@@ -0,0 +1,117 @@
+#include "polars/DataFrame.h"
+
+#include "polars/Series.h"
+#include "polars/SeriesMask.h"
+#include "polars/numc.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+
+
+namespace DataFrameTests {
+using DataFrame = polars::DataFrame;
+using Series = polars::Series;
+
+TEST(DataFrame, columns) {
+    Series a({1, 2, 3}, {10, 20, 30});
+    DataFrame df({"a", "b"}, {a, Series({4, 5, 6}, {10, 20, 30})});
+    df.add_column("c", arma::vec({7, 8, 9}));
+
+    EXPECT_EQ(df.columns(), std::vector<std::string>({"a", "b", "c"})) << "Expect " << "columns in insertion order";
+    EXPECT_EQ(df.size(), 3) << "Expect " << "one row per label";
+    EXPECT_EQ(df.n_columns(), 3) << "Expect " << "three columns";
+
+    EXPECT_PRED2(Series::equal, df["b"], Series({4, 5, 6}, {10, 20, 30})) << "Expect " << "columns by name";
+    EXPECT_EQ(df["a"].values().memptr(), df["a"].values().memptr()) << "Expect " << "columns without copying";
+
+    EXPECT_EQ(df["a"].index().memptr(), a.index().memptr()) << "Expect " << "the first column's index to be shared";
+    EXPECT_EQ(df["b"].index().memptr(), df.index().memptr()) << "Expect " << "equal indices to be rebased";
+    EXPECT_EQ(df["c"].index().memptr(), df.index().memptr()) << "Expect " << "new values to use the index";
+    EXPECT_EQ((df["a"] + df["b"]).index().memptr(), df.index().memptr())
+                        << "Expect " << "operations between columns to keep the shared index";
+
+    df.add_column("a", df["a"] * 2);
+    EXPECT_PRED2(Series::equal, df["a"], Series({2, 4, 6}, {10, 20, 30})) << "Expect " << "columns replaced by name";
+    EXPECT_EQ(df.n_columns(), 3) << "Expect " << "replacing a column not to add one";
+
+    EXPECT_THROW(df.add_column("d", Series({1, 2, 3}, {1, 2, 3})), std::invalid_argument)
+                        << "Expect " << "a column with a different index to be rejected";
+    EXPECT_THROW(df.add_column("d", arma::vec({1, 2})), std::invalid_argument)
+                        << "Expect " << "values of the wrong size to be rejected";
+    EXPECT_THROW(df["missing"], std::out_of_range) << "Expect " << "unknown columns to be rejected";
+
+    DataFrame from_empty;
+    from_empty.add_column("a", a);
+    EXPECT_EQ(from_empty.index().memptr(), a.index().memptr()) << "Expect " << "an empty DataFrame to take the index";
+}
+
+TEST(DataFrame, reductions) {
+    DataFrame df({"a", "b"}, {Series({1, 2, NAN}, {1, 2, 3}), Series({4, 6, 8}, {1, 2, 3})});
+
+    EXPECT_PRED2(polars::numc::equal_handling_nans, df.count(), arma::vec({2, 3})) << "Expect " << "count per column";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, df.sum(), arma::vec({3, 18})) << "Expect " << "sum per column";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, df.mean(), arma::vec({1.5, 6})) << "Expect " << "mean per column";
+    EXPECT_PRED2(polars::numc::almost_equal_handling_nans, df.std(), arma::vec({std::sqrt(0.5), 2}))
+                        << "Expect " << "std per column";
+}
+
+TEST(DataFrame, rolling_and_where) {
+    DataFrame df({"a", "b"}, {Series({1, 2, 3, 4}, {1, 2, 3, 4}), Series({4, 3, 2, 1}, {1, 2, 3, 4})});
+
+    DataFrame rolled = df.rolling(2, polars::Sum(), 1, false);
+    EXPECT_PRED2(Series::equal, rolled["a"], df["a"].rolling(2, polars::Sum(), 1, false))
+                        << "Expect " << "rolling to apply to each column";
+    EXPECT_PRED2(Series::equal, rolled["b"], df["b"].rolling(2, polars::Sum(), 1, false))
+                        << "Expect " << "rolling to apply to each column";
+    EXPECT_EQ(rolled.index().memptr(), df.index().memptr()) << "Expect " << "the result to share the index";
+
+    DataFrame kept = df.where(df["a"] > 2, 0);
+    EXPECT_PRED2(Series::equal, kept["a"], Series({0, 0, 3, 4}, {1, 2, 3, 4})) << "Expect " << "one mask for every column";
+    EXPECT_PRED2(Series::equal, kept["b"], Series({0, 0, 2, 1}, {1, 2, 3, 4})) << "Expect " << "one mask for every column";
+
+    DataFrame head = df.head(2);
+    EXPECT_PRED2(Series::equal, head["b"], Series({4, 3}, {1, 2})) << "Expect " << "the first rows of each column";
+    EXPECT_EQ(head["a"].index().memptr(), head["b"].index().memptr()) << "Expect " << "head to share one index";
+    EXPECT_PRED2(Series::equal, df.tail(1)["a"], Series({4}, {4})) << "Expect " << "the last rows of each column";
+
+    EXPECT_PRED2(DataFrame::equal, df, df.head(10)) << "Expect " << "head of more rows to be the same DataFrame";
+    EXPECT_PRED2(DataFrame::equal, df, df.head(-1)) << "Expect " << "negative n to give every row, like Series";
+    EXPECT_PRED2(DataFrame::equal, df, df.tail(-3));
+    EXPECT_PRED2(Series::equal, df.head(-1)["a"], df["a"].head(-1));
+}
+
+TEST(DataFrame, rolling_many) {
+    std::vector<Series> inputs;
+    for (int i = 0; i < 20; i++) {
+        arma::vec values = arma::regspace<arma::vec>(0, 49) * i;
+        inputs.push_back(Series(values, arma::regspace<arma::vec>(0, 49)));
+    }
+
+    polars::ThreadPool pool(4);
+    std::vector<Series> results = polars::rolling_many(inputs, 5, polars::Mean(), 1, true, false,
+                                                       polars::WindowProcessor::WindowType::none, -1, pool);
+    ASSERT_EQ(results.size(), inputs.size()) << "Expect " << "one result per input";
+    for (arma::uword i = 0; i < inputs.size(); i++) {
+        EXPECT_PRED2(Series::equal, results[i], inputs[i].rolling(5, polars::Mean(), 1))
+                            << "Expect " << "results in input order, the same as rolling each Series";
+    }
+
+    // One column long enough to be split into blocks as well, alongside short ones on the same pool.
+    arma::vec long_values = arma::linspace(0, 1000, 50000);
+    long_values.transform([](double val) { return 1e3 * std::sin(val); });
+    inputs.push_back(Series(long_values, arma::linspace(1, 50000, 50000)));
+    results = polars::rolling_many(inputs, 31, polars::Std(), 0, true, false,
+                                   polars::WindowProcessor::WindowType::none, -1, pool);
+    EXPECT_PRED2(Series::equal, results.back(), inputs.back().rolling(31, polars::Std()))
+                        << "Expect " << "a long column to match serial rolling";
+    EXPECT_PRED2(Series::equal, results[3], inputs[3].rolling(31, polars::Std()));
+
+    DataFrame df({"a", "b"}, {inputs[1], inputs[2]});
+    EXPECT_PRED2(DataFrame::equal, df.rolling(5, polars::Std()),
+                 df.rolling(5, polars::Std(), 0, true, false, polars::WindowProcessor::WindowType::none, -1, pool))
+                        << "Expect " << "the same DataFrame whichever pool is used";
+}
+
+}  // DataFrameTests
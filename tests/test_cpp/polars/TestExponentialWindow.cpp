@@ -0,0 +1,123 @@
+#include "polars/ExponentialWindow.h"
+
+#include "polars/Series.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+
+namespace ExponentialWindowTests {
+using namespace polars;
+
+// Weighted variance straight from the definition, for adjust = true and ignoreNA = false.
+double definition_var(const arma::vec &x, arma::uword last, double alpha, bool bias) {
+    double sumWeights = 0, sumSquaredWeights = 0, sumWeighted = 0;
+    for (arma::uword i = 0; i <= last; i++) {
+        if (!std::isfinite(x[i])) continue;
+        double weight = std::pow(1 - alpha, last - i);
+        sumWeights += weight;
+        sumSquaredWeights += weight * weight;
+        sumWeighted += weight * x[i];
+    }
+    double mean = sumWeighted / sumWeights;
+    double var = 0;
+    for (arma::uword i = 0; i <= last; i++) {
+        if (!std::isfinite(x[i])) continue;
+        var += std::pow(1 - alpha, last - i) * (x[i] - mean) * (x[i] - mean);
+    }
+    var /= sumWeights;
+    return bias ? var : var * sumWeights * sumWeights / (sumWeights * sumWeights - sumSquaredWeights);
+}
+
+TEST(ExponentialWindow, decay) {
+    EXPECT_DOUBLE_EQ(Decay::alpha(0.3).smoothing(), 0.3);
+    EXPECT_DOUBLE_EQ(Decay::com(1).smoothing(), 0.5) << "Expect " << "alpha = 1 / (1 + com)";
+    EXPECT_DOUBLE_EQ(Decay::span(3).smoothing(), 0.5) << "Expect " << "alpha = 2 / (span + 1)";
+    EXPECT_DOUBLE_EQ(Decay::halflife(1).smoothing(), 0.5) << "Expect " << "the weight to halve every halflife";
+
+    EXPECT_THROW(Decay::alpha(0), std::invalid_argument);
+    EXPECT_THROW(Decay::alpha(1.5), std::invalid_argument);
+    EXPECT_THROW(Decay::span(0.5), std::invalid_argument);
+    EXPECT_THROW(Decay::com(-1), std::invalid_argument);
+    EXPECT_THROW(Decay::halflife(0), std::invalid_argument);
+}
+
+TEST(ExponentialWindow, mean) {
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({1, 2, NAN, 4, 5, 6}, {1, 2, 3, 4, 5, 6}).ewm(Decay::alpha(0.5)).mean(),
+            Series({1.0, 1.6666666666666667, 1.6666666666666667, 3.3636363636363638, 4.333333333333333,
+                    5.237288135593221}, {1, 2, 3, 4, 5, 6})
+    ) << "Expect " << "matches pandas ewm(alpha=0.5).mean()";
+
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({NAN, NAN, 2, 3, NAN, 4}, {1, 2, 3, 4, 5, 6}).ewm(Decay::alpha(0.5)).mean(),
+            Series({NAN, NAN, 2.0, 2.6666666666666665, 2.6666666666666665, 3.6363636363636362}, {1, 2, 3, 4, 5, 6})
+    ) << "Expect " << "leading NANs to stay NAN and later ones to repeat the last mean";
+
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({1, NAN, 3}, {1, 2, 3}).ewm(Decay::alpha(0.5), true, true).mean(),
+            Series({1, 1, 2.3333333333333335}, {1, 2, 3})
+    ) << "Expect " << "ignoreNA to weight by the number of finite values only";
+
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({1, 2, 3}, {1, 2, 3}).ewm(Decay::alpha(0.5), false).mean(),
+            Series({1, 1.5, 2.25}, {1, 2, 3})
+    ) << "Expect " << "adjust = false to use y = (1 - alpha) * y + alpha * x";
+
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({1, NAN, 3, 4}, {1, 2, 3, 4}).ewm(Decay::alpha(0.5), true, false, 2).mean(),
+            Series({NAN, NAN, 2.6, 3.4615384615384617}, {1, 2, 3, 4})
+    ) << "Expect " << "NAN until minPeriods finite values have been seen";
+
+    EXPECT_PRED2(Series::equal, Series().ewm(Decay::alpha(0.5)).mean(), Series()) << "Expect " << "empty back";
+}
+
+TEST(ExponentialWindow, var_std_cov_corr) {
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({1, 2}, {1, 2}).ewm(Decay::alpha(0.5)).var(),
+            Series({NAN, 0.5}, {1, 2})
+    ) << "Expect " << "matches pandas ewm(alpha=0.5).var()";
+
+    EXPECT_PRED2(
+            Series::almost_equal,
+            Series({1, 2}, {1, 2}).ewm(Decay::alpha(0.5)).var(true),
+            Series({0, 2. / 9}, {1, 2})
+    ) << "Expect " << "the biased variance not to be corrected";
+
+    arma::vec values = {3, 1, NAN, 4, 1, 5, 9, NAN, NAN, 2, 6};
+    Series input(values, arma::linspace(1, 11, 11));
+    Series var = input.ewm(Decay::span(4)).var();
+    Series biased = input.ewm(Decay::span(4)).var(true);
+    for (arma::uword i = 1; i < values.n_elem; i++) {
+        EXPECT_NEAR(var.values()[i], definition_var(values, i, 0.4, false), 1e-12) << "at " << i;
+        EXPECT_NEAR(biased.values()[i], definition_var(values, i, 0.4, true), 1e-12) << "at " << i;
+    }
+
+    EXPECT_PRED2(Series::almost_equal, input.ewm(Decay::span(4)).std(), var.pow(0.5))
+                        << "Expect " << "std to be the square root of var";
+    EXPECT_PRED2(Series::almost_equal, input.ewm(Decay::span(4)).cov(input), var)
+                        << "Expect " << "the covariance with itself to be the variance";
+
+    Series corr = input.ewm(Decay::span(4)).corr(input * -2 + 1);
+    EXPECT_NEAR(corr.values()[10], -1, 1e-12) << "Expect " << "a perfect negative correlation";
+
+    // A NAN in only one input drops that observation from both variances too, as pandas does.
+    arma::vec oneSided = values * -2 + 1;
+    oneSided[4] = NAN;
+    Series oneSidedCorr = input.ewm(Decay::span(4)).corr(Series(oneSided, input.index()));
+    for (arma::uword i = 4; i < values.n_elem; i++) {
+        EXPECT_NEAR(oneSidedCorr.values()[i], -1, 1e-12) << "Expect " << "a perfect negative correlation at " << i;
+    }
+
+    Series other({1, 2, 3}, {2, 4, 12});
+    EXPECT_EQ(input.ewm(Decay::span(4)).cov(other).size(), 12) << "Expect " << "the inputs to be outer aligned";
+}
+
+}  // ExponentialWindowTests
@@ -0,0 +1,81 @@
+#include "polars/Instrumentation.h"
+
+#include "polars/Series.h"
+#include "polars/SeriesMask.h"
+#include "polars/ThreadPool.h"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <vector>
+
+
+namespace InstrumentationTests {
+using namespace polars;
+
+const instrumentation::OperationStats *find(const std::vector<instrumentation::OperationStats> &report,
+                                            const std::string &name) {
+    for (const auto &stats : report) {
+        if (stats.name == name) return &stats;
+    }
+    return nullptr;
+}
+
+TEST(Instrumentation, report) {
+    instrumentation::reset();
+
+    Series a(arma::linspace(0, 1, 1000), arma::linspace(1, 1000, 1000));
+    a.head(500);
+    a.head(10);
+    a.rolling(5).mean();
+    auto report = instrumentation::report();
+
+    std::ostringstream table;
+    instrumentation::dump(table);
+    EXPECT_NE(table.str().find("operation"), std::string::npos) << "Expect " << "a header whether enabled or not";
+
+#ifdef POLARS_INSTRUMENTATION
+    const instrumentation::OperationStats *head = find(report, "Series::head");
+    ASSERT_NE(head, nullptr);
+    EXPECT_EQ(head->calls, 2);
+    EXPECT_GE(head->allocations, 2) << "Expect " << "each head to allocate its values";
+    EXPECT_GE(head->bytes, 510 * sizeof(double));
+
+    const instrumentation::OperationStats *mean = find(report, "Rolling::mean");
+    const instrumentation::OperationStats *rolling = find(report, "Series::rolling");
+    ASSERT_NE(mean, nullptr);
+    ASSERT_NE(rolling, nullptr);
+    EXPECT_GE(mean->bytes, rolling->bytes) << "Expect " << "figures to include the operations called";
+    EXPECT_NE(table.str().find("Series::head"), std::string::npos);
+
+    SeriesMask mask = a > 0.5;
+    ((!mask) | (mask & mask)).count();
+    const instrumentation::OperationStats *negation = find(instrumentation::report(), "SeriesMask::operator!");
+    ASSERT_NE(negation, nullptr);
+    EXPECT_EQ(negation->calls, 1);
+    EXPECT_GE(negation->allocations, 1) << "Expect " << "mask operators to be counted too";
+
+    instrumentation::reset();
+    EXPECT_TRUE(instrumentation::report().empty()) << "Expect " << "reset to clear the report";
+#else
+    EXPECT_TRUE(report.empty()) << "Expect " << "nothing to be recorded unless built with POLARS_INSTRUMENTATION";
+#endif
+}
+
+#ifdef POLARS_INSTRUMENTATION
+TEST(Instrumentation, thread_pool) {
+    ThreadPool pool(4);
+    std::vector<std::vector<double>> buffers(64);
+    instrumentation::AllocationCount before = instrumentation::thread_allocations();
+    pool.parallel_for(buffers.size(), [&buffers](arma::uword i) {
+        buffers[i].resize(1000);
+    });
+    instrumentation::AllocationCount after = instrumentation::thread_allocations();
+    // parallel_for's own bookkeeping allocates on the caller as well, so the buffers give a lower bound.
+    EXPECT_GE(after.allocations - before.allocations, buffers.size());
+    EXPECT_GE(after.bytes - before.bytes, buffers.size() * 1000 * sizeof(double))
+                        << "Expect " << "allocations on the workers to be charged to the caller";
+}
+#endif
+
+}  // InstrumentationTests
@@ -66,6 +66,26 @@ TEST(Series, not_equal) {
                         << "Expect " << "swapping index and values results in no match" << "";
 }
 
+TEST(Series, accessors) {
+    Series s({3, 4}, {1, 2});
+
+    EXPECT_EQ(s.values().memptr(), s.values().memptr()) << "Expect " << "values() to return the data without copying";
+    EXPECT_EQ(s.index().memptr(), s.index().memptr()) << "Expect " << "index() to return the data without copying";
+}
+
+TEST(Series, shared_index) {
+    Series s({3, 4}, {1, 2});
+
+    EXPECT_EQ(s.index().memptr(), (s + 1).index().memptr()) << "Expect " << "arithmetic results to share the index";
+    EXPECT_EQ(s.index().memptr(), (s * s).abs().pow(2).fillna().index().memptr())
+                        << "Expect " << "chained element-wise results to share the index";
+    EXPECT_EQ(s.index().memptr(), (s > 3).index().memptr()) << "Expect " << "comparisons to share the index";
+    EXPECT_EQ(s.index().memptr(), Series(!(s > 3)).where(s > 3, 0).index().memptr())
+                        << "Expect " << "conversions between Series and SeriesMask to share the index";
+    EXPECT_NE(s.index().memptr(), Series({3, 4}, {1, 2}).index().memptr())
+                        << "Expect " << "Series constructed separately to have their own index";
+}
+
 TEST(Series, where) {
     EXPECT_PRED2(
             Series::equal,
@@ -78,6 +98,36 @@ TEST(Series, where) {
             Series({3, 4}, {1, 2}).where(polars::SeriesMask({0, 1}, {1, 2}), NAN),
             Series({NAN, 4}, {1, 2})
     ) << "Expect " << ".where(..., NAN) to not set everything to NAN";
+
+    EXPECT_THROW(Series({3, 4}, {1, 2}).where(polars::SeriesMask({0}, {1})), std::logic_error)
+                        << "Expect " << "a mask of a different size to be rejected";
+}
+
+TEST(Series, mask) {
+    Series s({3, 4, NAN, 6}, {1, 2, 3, 4});
+
+    EXPECT_PRED2(Series::equal, s.mask(s > 3.5, 0), Series({3, 0, NAN, 0}, {1, 2, 3, 4}))
+                        << "Expect " << "values where the condition holds to be replaced";
+
+    EXPECT_PRED2(Series::equal, s.mask(s > 3.5), s.where(!(s > 3.5)))
+                        << "Expect " << "mask() to be the inverse of where()";
+}
+
+TEST(Series, operator__mask_filter) {
+    Series s({3, 4, NAN, 6}, {1, 2, 3, 4});
+
+    EXPECT_PRED2(Series::equal, s[s > 3.5], Series({4, 6}, {2, 4}))
+                        << "Expect " << "only the values and labels where the condition holds";
+
+    EXPECT_PRED2(Series::equal, s[s > 10], Series()) << "Expect " << "an empty Series when nothing matches";
+
+    EXPECT_EQ(s[(s == s) | !(s == s)].index().memptr(), s.index().memptr())
+                        << "Expect " << "an all-true mask to keep the Series as it is";
+
+    arma::vec values = arma::regspace<arma::vec>(0, 199);
+    Series large(values, values);
+    EXPECT_PRED2(Series::equal, large[large >= 130], large.iloc(130, 200))
+                        << "Expect " << "filtering to work across the words of the mask";
 }
 
 TEST(Series, DiffTest) {
@@ -258,6 +308,68 @@ TEST(Series, StdTest) {
 
 }
 
+TEST(Series, align) {
+    Series a({1, 2, 3}, {1, 2, 4});
+    Series b({10, 20, 30}, {2, 3, 4});
+
+    auto outer = a.align(b);
+    EXPECT_PRED2(Series::equal, outer.first, Series({1, 2, NAN, 3}, {1, 2, 3, 4}))
+                        << "Expect " << "labels missing from the left to be NAN";
+    EXPECT_PRED2(Series::equal, outer.second, Series({NAN, 10, 20, 30}, {1, 2, 3, 4}))
+                        << "Expect " << "labels missing from the right to be NAN";
+    EXPECT_EQ(outer.first.index().memptr(), outer.second.index().memptr())
+                        << "Expect " << "both sides to share the aligned index";
+
+    auto inner = a.align(b, Series::Join::inner);
+    EXPECT_PRED2(Series::equal, inner.first, Series({2, 3}, {2, 4}))
+                        << "Expect " << "only labels on both sides";
+    EXPECT_PRED2(Series::equal, inner.second, Series({10, 30}, {2, 4}))
+                        << "Expect " << "only labels on both sides";
+
+    auto unsorted = Series({1, 2, 3}, {4, 1, 2}).align(Series({10, 20}, {2, 5}));
+    EXPECT_PRED2(Series::equal, unsorted.first, Series({2, 3, 1, NAN}, {1, 2, 4, 5}))
+                        << "Expect " << "unsorted indices to be aligned in label order";
+    EXPECT_PRED2(Series::equal, unsorted.second, Series({NAN, 10, NAN, 20}, {1, 2, 4, 5}))
+                        << "Expect " << "unsorted indices to be aligned in label order";
+
+    auto duplicates = Series({1, 2, 3}, {1, 1, 2}).align(Series({10, 20}, {1, 1}), Series::Join::inner);
+    EXPECT_PRED2(Series::equal, duplicates.first, Series({1, 1, 2, 2}, {1, 1, 1, 1}))
+                        << "Expect " << "every pairing of a repeated label";
+    EXPECT_PRED2(Series::equal, duplicates.second, Series({10, 20, 10, 20}, {1, 1, 1, 1}))
+                        << "Expect " << "every pairing of a repeated label";
+
+    Series c = a * 2;
+    auto same = a.align(c);
+    EXPECT_EQ(same.second.index().memptr(), a.index().memptr())
+                        << "Expect " << "an already aligned Series to keep its index";
+    EXPECT_TRUE(a.is_aligned_with(c)) << "Expect " << "derived Series to be aligned";
+    EXPECT_TRUE(a.is_aligned_with(Series({0, 0, 0}, {1, 2, 4}))) << "Expect " << "equal indices to be aligned";
+    EXPECT_FALSE(a.is_aligned_with(b)) << "Expect " << "different indices not to be aligned";
+}
+
+
+TEST(Series, operator__misaligned) {
+    Series a({1, 2, 3}, {1, 2, 4});
+    Series b({10, 20, 30}, {2, 3, 4});
+
+    EXPECT_PRED2(Series::equal, a + b, Series({NAN, 12, NAN, 33}, {1, 2, 3, 4}))
+                        << "Expect " << "arithmetic over the union of the labels";
+    EXPECT_PRED2(Series::equal, b - a, Series({NAN, 8, NAN, 27}, {1, 2, 3, 4}))
+                        << "Expect " << "arithmetic over the union of the labels";
+    EXPECT_PRED2(Series::equal, a * b, Series({NAN, 20, NAN, 90}, {1, 2, 3, 4}))
+                        << "Expect " << "arithmetic over the union of the labels";
+
+    EXPECT_PRED2(polars::SeriesMask::equal, b > a, polars::SeriesMask({1, 1}, {2, 4}))
+                        << "Expect " << "comparisons over the labels on both sides";
+    EXPECT_PRED2(polars::SeriesMask::equal, a < b, polars::SeriesMask({1, 1}, {2, 4}))
+                        << "Expect " << "comparisons over the labels on both sides";
+    EXPECT_PRED2(polars::SeriesMask::equal, a == Series({3, 2}, {4, 1}), polars::SeriesMask({0, 1}, {1, 4}))
+                        << "Expect " << "comparisons over the labels on both sides";
+    EXPECT_PRED2(polars::SeriesMask::equal, a != Series({3, 2}, {4, 1}), polars::SeriesMask({1, 0}, {1, 4}))
+                        << "Expect " << "comparisons over the labels on both sides";
+}
+
+
 TEST(Series, operator__add) {
     EXPECT_PRED2(
             Series::equal,
@@ -604,6 +716,36 @@ TEST(Series, loc) {
             Series({10, 30, 40, 20}, {3, 4, 5, 6}).loc(8),
             Series()
     ) << "Expect " << "empty indices since no records match label";
+
+    EXPECT_PRED2(
+            Series::equal,
+            Series({1, 2, 3, 4, 5}, {1, 2, 2, 2, 3}).loc(2),
+            Series({2, 3, 4}, {2, 2, 2})
+    ) << "Expect " << "every value with a duplicated label in a sorted index";
+
+    EXPECT_PRED2(
+            Series::equal,
+            Series({1, 2, 3, 4, 5}, {1, 2, 2, 2, 3}).loc(arma::vec{3, 0, 2, 1}),
+            Series({5, 2, 1}, {3, 2, 1})
+    ) << "Expect " << "first match of each label, in label order, from a sorted index";
+
+    EXPECT_PRED2(
+            Series::equal,
+            Series({10, 30, 40, 20, 50}, {6, 3, 5, 3, 4}).loc(arma::vec{3, 4, 7, 6}),
+            Series({30, 50, 10}, {3, 4, 6})
+    ) << "Expect " << "first match of each label, in label order, from an unsorted index";
+
+    EXPECT_PRED2(
+            Series::equal,
+            Series({10, 30, 40, 20, 50}, {6, 3, 5, 3, 4}).loc(3),
+            Series({30, 20}, {3, 3})
+    ) << "Expect " << "every value with a duplicated label in an unsorted index";
+
+    EXPECT_PRED2(
+            Series::equal,
+            Series({10, 30, 40}, {1, NAN, 3}).loc(arma::vec{3, 1}),
+            Series({40, 10}, {3, 1})
+    ) << "Expect " << "labels found in an index containing NANs";
 }
 
 TEST(Series, index_as_series) {
@@ -0,0 +1,55 @@
+#include "polars/SeriesExpression.h"
+
+#include "polars/Series.h"
+#include "polars/SeriesMask.h"
+
+#include "gtest/gtest.h"
+
+
+namespace SeriesExpressionTests {
+using namespace polars;
+
+TEST(SeriesExpression, arithmetic) {
+    Series a({1, 2, NAN, 4}, {1, 2, 3, 4});
+    Series b({0.5, 3, 1, -1}, {1, 2, 3, 4});
+    Series c({10, 20, 30, 40}, {1, 2, 3, 4});
+
+    Series actual = (lazy(a) - b) * 2.0 + c;
+    EXPECT_PRED2(Series::equal, actual, (a - b) * 2.0 + c) << "Expect " << "the same result as eager evaluation";
+
+    EXPECT_PRED2(Series::equal, (1.5 - lazy(a) * 3).eval(), Series({-1.5, -4.5, NAN, -10.5}, {1, 2, 3, 4}))
+                        << "Expect " << "scalars on either side of an operator";
+
+    EXPECT_PRED2(Series::equal, (lazy(a) - b).abs().pow(2).eval(), (a - b).abs().pow(2))
+                        << "Expect " << "abs() and pow() to match Series";
+
+    EXPECT_PRED2(Series::equal, (lazy(a) * 2).clip(3, 5).eval(), (a * 2).clip(3, 5))
+                        << "Expect " << "clip() to match Series, including for NAN";
+
+    EXPECT_EQ(a.index().memptr(), actual.index().memptr()) << "Expect " << "the result to share the index";
+
+    EXPECT_THROW((lazy(a) + Series({1}, {1})).eval(), std::logic_error)
+                        << "Expect " << "mismatched sizes to be rejected";
+
+    EXPECT_THROW((lazy(a) + Series({1, 2, 3, 4}, {1, 2, 3, 5})).eval(), std::logic_error)
+                        << "Expect " << "mismatched indices to be rejected";
+}
+
+TEST(SeriesExpression, comparisons) {
+    Series a({1, 2, NAN, 4}, {1, 2, 3, 4});
+    Series b({0.5, 3, 1, -1}, {1, 2, 3, 4});
+
+    SeriesMask actual = lazy(a) - b > 0;
+    EXPECT_PRED2(SeriesMask::equal, actual, SeriesMask({1, 0, 0, 1}, {1, 2, 3, 4}))
+                        << "Expect " << "comparisons to produce a SeriesMask";
+
+    EXPECT_PRED2(SeriesMask::equal, (lazy(a) > b).eval(), a > b) << "Expect " << "the same result as eager evaluation";
+
+    EXPECT_PRED2(SeriesMask::equal, ((lazy(a) >= 2) & (lazy(b) <= 1)).eval(), SeriesMask({0, 0, 0, 1}, {1, 2, 3, 4}))
+                        << "Expect " << "masks to combine with &";
+
+    EXPECT_PRED2(SeriesMask::equal, ((!(lazy(a) == b)) | (lazy(a) != a)).eval(), SeriesMask({1, 1, 1, 1}, {1, 2, 3, 4}))
+                        << "Expect " << "masks to combine with | and !";
+}
+
+}  // SeriesExpressionTests
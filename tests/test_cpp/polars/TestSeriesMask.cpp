@@ -5,6 +5,7 @@
 #include "polars/SeriesMask.h"
 
 #include "polars/Series.h"
+#include "polars/numc.h"
 
 #include "gtest/gtest.h"
 
@@ -85,4 +86,42 @@ namespace SeriesMaskTests {
       ) << "Expect " << "logical !=";
     }
 
+    TEST(SeriesMask, bit_packed) {
+        // Crosses several 64-bit words, with a partly used last word.
+        arma::uword n = 150;
+        arma::uvec flags(n);
+        for (arma::uword i = 0; i < n; i++) {
+            flags[i] = (i % 3 == 0) || i == 149;
+        }
+        arma::vec index = arma::regspace<arma::vec>(0, n - 1);
+        polars::SeriesMask mask(flags, index);
+
+        EXPECT_TRUE(polars::numc::equal(mask.values(), flags)) << "Expect " << "values to unpack as they were given";
+        EXPECT_EQ(mask.count(), 51) << "Expect " << "count of the true values";
+        EXPECT_EQ((!mask).count(), 99) << "Expect " << "NOT to leave the bits past the end clear";
+        EXPECT_EQ((mask | !mask).count(), n) << "Expect " << "logical OR over every word";
+        EXPECT_EQ((mask & !mask).count(), 0) << "Expect " << "logical AND over every word";
+        EXPECT_EQ((mask == mask).count(), n) << "Expect " << "logical == over every word";
+        EXPECT_EQ((mask != !mask).count(), n) << "Expect " << "logical != over every word";
+
+        arma::uvec positions = mask.bits().find();
+        EXPECT_EQ(positions.n_elem, 51) << "Expect " << "one position per true value";
+        EXPECT_EQ(positions[1], 3) << "Expect " << "positions in order";
+        EXPECT_EQ(positions[50], 149) << "Expect " << "positions in the last word";
+
+        EXPECT_EQ(polars::SeriesMask({2, 0, 5}, {1, 2, 3}).count(), 2) << "Expect " << "any non-zero value to be true";
+        EXPECT_TRUE(polars::numc::equal(polars::SeriesMask({2, 0, 5}, {1, 2, 3}).values(), arma::uvec({1, 0, 1})))
+                            << "Expect " << "non-zero values to read back as 1";
+
+        EXPECT_EQ(&mask.values(), &mask.values()) << "Expect " << "the values to be unpacked once and kept";
+        polars::SeriesMask copy = mask;
+        EXPECT_NE(&copy.values(), &mask.values()) << "Expect " << "copies not to keep the unpacked values alive";
+        EXPECT_TRUE(polars::numc::equal(copy.values(), flags));
+        copy = !mask;
+        EXPECT_EQ(copy.values()[0], 0) << "Expect " << "assignment to replace the unpacked values";
+
+        EXPECT_TRUE(polars::numc::equal(mask.iloc(arma::uvec({146, 147, 149})).values(), arma::uvec({0, 1, 1})))
+                            << "Expect " << "iloc to pick out bits";
+    }
+
 }  // SeriesMaskTests
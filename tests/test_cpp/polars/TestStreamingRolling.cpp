@@ -0,0 +1,101 @@
+#include "polars/StreamingRolling.h"
+
+#include "polars/Series.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+
+
+namespace StreamingRollingTests {
+using namespace polars;
+
+// Streams input through a StreamingRolling, collecting the value after each push.
+Series stream(const Series &input, arma::uword windowSize, const WindowProcessor &processor,
+              arma::uword minPeriods) {
+    StreamingRolling rolling(windowSize, processor, minPeriods);
+    arma::vec result(input.size());
+    for (arma::uword i = 0; i < input.size(); i++) {
+        result[i] = rolling.push(input.index()[i], input.values()[i]);
+    }
+    return Series(result, input.index());
+}
+
+// On a unit-spaced index, the offset window (label - w, label] is the last w values.
+void expect_stream_matches_offset_rolling(const Series &input, const WindowProcessor &processor) {
+    for (arma::uword windowSize : {1, 3, 10}) {
+        for (arma::uword minPeriods : {1, 2}) {
+            EXPECT_PRED2(
+                    Series::almost_equal,
+                    stream(input, windowSize, processor, minPeriods),
+                    input.rolling_offset(windowSize, processor, minPeriods)
+            ) << "Expect " << "streaming and offset rolling to agree for window=" << windowSize
+              << ", min_periods=" << minPeriods;
+        }
+    }
+}
+
+TEST(StreamingRolling, matches_trailing_rolling) {
+    arma::vec values = arma::linspace(0, 20, 50);
+    values.transform([](double val) { return 10 * std::sin(val) + 0.1; });
+    values(7) = NAN;
+    values(8) = NAN;
+    values(30) = NAN;
+    Series input(values, arma::linspace(1, 50, 50));
+
+    expect_stream_matches_offset_rolling(input, Count());
+    expect_stream_matches_offset_rolling(input, Sum());
+    expect_stream_matches_offset_rolling(input, Mean());
+    expect_stream_matches_offset_rolling(input, Std());
+    expect_stream_matches_offset_rolling(input, RollingMin());
+    expect_stream_matches_offset_rolling(input, RollingMax());
+    expect_stream_matches_offset_rolling(input, Quantile(0.3));
+}
+
+// A batch rolling over just the last window starts from scratch, so has none of the stream's history to drift with.
+void expect_stream_matches_last_window(const Series &input, arma::uword windowSize, const WindowProcessor &processor) {
+    StreamingRolling rolling(windowSize, processor, 1);
+    for (arma::uword i = 0; i < input.size(); i++) {
+        rolling.push(input.index()[i], input.values()[i]);
+    }
+    double expected = input.tail(windowSize).rolling_offset(windowSize, processor).values()[windowSize - 1];
+    EXPECT_NEAR(rolling.value(), expected, 1e-12 * std::abs(expected))
+                        << "Expect " << "no drift after " << input.size() << " pushes";
+}
+
+TEST(StreamingRolling, long_stream) {
+    // Bursts of huge values between small ones, which leave rounding errors behind in running sums and variances.
+    arma::uword n = 200000;
+    arma::vec values(n);
+    for (arma::uword i = 0; i < n; i++) {
+        values[i] = std::sin(i * 0.1) + (i % 997 < 20 ? 1e9 * std::cos(i * 0.3) : 0);
+    }
+    Series input(values, arma::regspace<arma::vec>(1, n));
+
+    expect_stream_matches_last_window(input, 50, Sum());
+    expect_stream_matches_last_window(input, 50, Mean());
+    expect_stream_matches_last_window(input, 50, Std());
+}
+
+TEST(StreamingRolling, window) {
+    StreamingRolling rolling(3, Mean(), 2);
+
+    EXPECT_TRUE(std::isnan(rolling.push(1, 1))) << "Expect " << "NAN until there are minPeriods values";
+    EXPECT_EQ(rolling.push(2, 2), 1.5);
+    EXPECT_EQ(rolling.push(3, 3), 2);
+    EXPECT_EQ(rolling.push(5, NAN), 2.5) << "Expect " << "the oldest value to drop out and NANs to be skipped";
+    EXPECT_EQ(rolling.size(), 3);
+    EXPECT_PRED2(Series::equal, rolling.window(), Series({2, 3, NAN}, {2, 3, 5}))
+                        << "Expect " << "the window oldest first";
+
+    EXPECT_THROW(rolling.push(4, 1), std::invalid_argument) << "Expect " << "timestamps going back to be rejected";
+
+    rolling.reset();
+    EXPECT_EQ(rolling.size(), 0);
+    EXPECT_PRED2(Series::equal, rolling.window(), Series()) << "Expect " << "reset to empty the window";
+
+    EXPECT_THROW(StreamingRolling(0, Mean()), std::invalid_argument);
+}
+
+}  // StreamingRollingTests
@@ -0,0 +1,43 @@
+#include "polars/ThreadPool.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+
+namespace ThreadPoolTests {
+using ThreadPool = polars::ThreadPool;
+
+TEST(ThreadPool, parallel_for) {
+    for (unsigned threads : {1u, 2u, 4u}) {
+        ThreadPool pool(threads);
+        EXPECT_EQ(pool.size(), threads) << "Expect " << "the requested number of threads";
+
+        std::vector<int> visits(1000, 0);
+        pool.parallel_for(visits.size(), [&visits](arma::uword i) { visits[i]++; });
+        EXPECT_EQ(visits, std::vector<int>(1000, 1)) << "Expect " << "every task to run exactly once";
+    }
+
+    EXPECT_GE(ThreadPool(0).size(), 1) << "Expect " << "a thread per hardware thread by default";
+}
+
+TEST(ThreadPool, nested_and_errors) {
+    ThreadPool pool(3);
+
+    std::atomic<int> count(0);
+    pool.parallel_for(8, [&pool, &count](arma::uword) {
+        pool.parallel_for(8, [&count](arma::uword) { count++; });
+    });
+    EXPECT_EQ(count, 64) << "Expect " << "nested parallel_for to complete";
+
+    std::atomic<int> completed(0);
+    EXPECT_THROW(pool.parallel_for(10, [&completed](arma::uword i) {
+        if (i == 3) throw std::runtime_error("task failed");
+        completed++;
+    }), std::runtime_error) << "Expect " << "a task's exception to reach the caller";
+    EXPECT_EQ(completed, 9) << "Expect " << "the other tasks to still run";
+}
+
+}  // ThreadPoolTests
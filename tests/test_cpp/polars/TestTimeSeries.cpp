@@ -187,6 +187,40 @@ TEST(TimeSeries, to_timeseries_map) {
 };
 
 
+TEST(TimeSeries, nanosecond_timestamps) {
+
+    using TimePoint = time_point<system_clock, nanoseconds>;
+
+    // Consecutive nanoseconds in 2023, beyond the 2^53 ticks a double holds exactly, so all three labels are equal.
+    TimePoint t1{nanoseconds(1700000000000000001)};
+    TimePoint t2{nanoseconds(1700000000000000002)};
+    TimePoint t3{nanoseconds(1700000000000000003)};
+    std::vector<TimePoint> tpoints = {t1, t2, t3};
+
+    TimeSeries<TimePoint> ts({1, NAN, 3}, tpoints);
+    ASSERT_EQ(ts.index()[0], ts.index()[2]);
+
+    EXPECT_EQ(ts.timestamps(), tpoints) << "Expect " << "the time points to round-trip exactly";
+    EXPECT_EQ(ts.timestamps()[1], t2);
+    EXPECT_EQ(ts.tail(2).timestamps(), std::vector<TimePoint>({t2, t3}));
+    EXPECT_EQ(TimeSeries<TimePoint>::from_series(ts.dropna()).timestamps(), std::vector<TimePoint>({t1, t3}));
+    EXPECT_EQ(TimeSeries<TimePoint>::from_series(ts[ts > 2]).timestamps(), std::vector<TimePoint>({t3}));
+    EXPECT_EQ(TimeSeries<TimePoint>::from_series(ts * 2).timestamps(), tpoints)
+                        << "Expect " << "element-wise operations to keep the exact time points";
+    EXPECT_EQ(TimeSeriesMask<TimePoint>::from_series_mask(ts > 2).timestamps(), tpoints);
+
+    EXPECT_EQ(&TimeSeries<TimePoint>::from_series(ts * 2).index(), &ts.index())
+                        << "Expect " << "the labels built from the ticks to be shared by every copy of the index";
+    TimeSeries<TimePoint> shifted({1, 2, 3}, {t1, t2, t3 + nanoseconds(1)});
+    EXPECT_FALSE(ts.is_aligned_with(shifted)) << "Expect " << "indices of ticks to be compared exactly";
+    EXPECT_TRUE(ts.is_aligned_with(TimeSeries<TimePoint>({0, 0, 0}, tpoints)));
+
+    std::map<TimePoint, double> ts_map = ts.to_timeseries_map();
+    EXPECT_EQ(ts_map.size(), 3) << "Expect " << "a key per time point rather than one rounded key";
+    EXPECT_EQ(TimeSeries<TimePoint>::from_map(ts_map).timestamps(), tpoints);
+};
+
+
 TEST(TimeSeries, to_timeseries_map__minutes) {
 
     using TimePoint = time_point<system_clock, minutes>;
@@ -260,6 +294,71 @@ TEST(TimeSeries, loc) {
     EXPECT_TRUE(ts_empty.empty()) << "Expect " << " true since timeseries is empty";
 }
 
+TEST(TimeSeries, rolling) {
+    using TP = time_point<system_clock, seconds>;
+
+    std::vector<TP> tpoints = {TP(seconds(0)), TP(seconds(60)), TP(seconds(90)), TP(seconds(400)), TP(seconds(420))};
+    auto ts = polars::SecondsTimeSeries({1, 2, 3, 4, 5}, tpoints);
+
+    EXPECT_PRED2(
+            polars::numc::equal_handling_nans,
+            ts.rolling(minutes(2)).sum().values(),
+            arma::vec({1, 3, 6, 4, 9})
+    ) << "Expect " << "windows covering the preceding two minutes of irregularly sampled data";
+
+    EXPECT_PRED2(
+            polars::numc::equal_handling_nans,
+            ts.rolling(milliseconds(60500), 2).mean().values(),
+            arma::vec({NAN, 1.5, 2.5, NAN, 4.5})
+    ) << "Expect " << "windows finer than the index resolution and min_periods to be respected";
+
+    EXPECT_PRED2(
+            polars::numc::equal_handling_nans,
+            ts.rolling(2).sum().values(),
+            arma::vec({NAN, 3, 5, 7, 9})
+    ) << "Expect " << "rolling by a number of values to still be available";
+}
+
+TEST(TimeSeries, resample) {
+    using TP = time_point<system_clock, milliseconds>;
+
+    std::vector<TP> tpoints = {TP(milliseconds(1000)), TP(milliseconds(1500)), TP(milliseconds(1999)),
+                               TP(milliseconds(2000)), TP(milliseconds(4200)), TP(milliseconds(4300))};
+    auto ts = polars::MillisecondsTimeSeries({3, NAN, 5, 1, 2, 4}, tpoints);
+    arma::vec buckets = {1000, 2000, 3000, 4000};
+
+    auto per_second = ts.resample(seconds(1));
+
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.sum().index(), buckets)
+                        << "Expect " << "every bucket from the first to the last, labelled with its start";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.sum().values(), arma::vec({8, 1, 0, 6}))
+                        << "Expect " << "sums ignoring NANs, with 0 for empty buckets";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.mean().values(), arma::vec({4, 1, NAN, 3}))
+                        << "Expect " << "means ignoring NANs";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.min().values(), arma::vec({3, 1, NAN, 2}))
+                        << "Expect " << "minimum per bucket";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.max().values(), arma::vec({5, 1, NAN, 4}))
+                        << "Expect " << "maximum per bucket";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.first().values(), arma::vec({3, 1, NAN, 2}))
+                        << "Expect " << "first value per bucket";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.last().values(), arma::vec({5, 1, NAN, 4}))
+                        << "Expect " << "last value per bucket";
+    EXPECT_PRED2(polars::numc::equal_handling_nans, per_second.count().values(), arma::vec({2, 1, 0, 2}))
+                        << "Expect " << "number of finite values per bucket";
+
+    auto bars = per_second.ohlc();
+    EXPECT_PRED2(polars::MillisecondsTimeSeries::equal, bars.open, per_second.first()) << "Expect " << "open";
+    EXPECT_PRED2(polars::MillisecondsTimeSeries::equal, bars.high, per_second.max()) << "Expect " << "high";
+    EXPECT_PRED2(polars::MillisecondsTimeSeries::equal, bars.low, per_second.min()) << "Expect " << "low";
+    EXPECT_PRED2(polars::MillisecondsTimeSeries::equal, bars.close, per_second.last()) << "Expect " << "close";
+
+    std::vector<TP> timestamps = per_second.sum().timestamps();
+    EXPECT_EQ(timestamps[3], TP(seconds(4))) << "Expect " << "bucket timestamps in the original time point type";
+
+    EXPECT_TRUE(polars::MillisecondsTimeSeries().resample(minutes(1)).sum().empty())
+                        << "Expect " << "empty TimeSeries stays empty";
+}
+
 TEST(TimeSeries, prettyprint) {
 
     // TODO: Add test for larger timeseries.
@@ -4,8 +4,10 @@
 
 #include "polars/WindowProcessor.h"
 
+#include "polars/ExponentialWindow.h"
 #include "polars/Series.h"
 #include "polars/SeriesMask.h"
+#include "polars/ThreadPool.h"
 #include "polars/numc.h"
 
 #include "gtest/gtest.h"
@@ -138,6 +140,10 @@ TEST(Series, rolling_min) {
     EXPECT_PRED2(Series::equal, Series(arma::vec({1, 1, 1}), arma::vec({1, 2, 3})),
                  Series(arma::vec({1, NAN, 1}), arma::vec({1, 2, 3})).rolling(3, 1, true).min())
                         << "Expect " << "series of size 3, rolling window of 3" << "";
+
+    EXPECT_PRED2(Series::equal, Series(arma::vec({NAN, 2, 2, 2, 0, 0}), arma::vec({1, 2, 3, 4, 5, 6})),
+                 Series(arma::vec({2, 2, 3, 2, 0, 0}), arma::vec({1, 2, 3, 4, 5, 6})).rolling(2).min())
+                        << "Expect " << "repeated values to leave the window one at a time" << "";
 }
 
 
@@ -227,7 +233,7 @@ TEST(Series, rolling_std) {
     ) << "Expect " << "with a window of 3 any windows with 3 non-NAN values should be the std, not NAN";
 
     EXPECT_PRED2(
-            Series::equal,
+            Series::almost_equal,
             Series({1, 2, 3.5, -1, NAN}, {1, 2, 3, 4, 5}).rolling(3, polars::Std(), 2),
             Series({
                            arma::stddev(arma::vec{1, 2}),
@@ -305,6 +311,101 @@ TEST(Series, rolling_count) {
 }
 
 
+// Hides the accumulator of the wrapped processor so that Series::rolling evaluates every window from scratch.
+template<class Processor>
+class PerWindow : public polars::WindowProcessor {
+public:
+    explicit PerWindow(const Processor &processor) : processor(processor) {}
+
+    double processWindow(const Series &window, const arma::vec &weights) const {
+        return processor.processWindow(window, weights);
+    }
+
+    double defaultValue() const {
+        return processor.defaultValue();
+    }
+
+private:
+    Processor processor;
+};
+
+template<class Processor>
+void expect_incremental_matches_per_window(const Series &input, const Processor &processor) {
+    for (arma::uword windowSize : {1, 2, 3, 4, 7, 10, 60}) {
+        for (arma::uword minPeriods : {0, 1, 2}) {
+            for (bool center : {true, false}) {
+                for (bool symmetric : {true, false}) {
+                    EXPECT_PRED2(
+                            Series::almost_equal,
+                            input.rolling(windowSize, processor, minPeriods, center, symmetric),
+                            input.rolling(windowSize, PerWindow<Processor>(processor), minPeriods, center, symmetric)
+                    ) << "Expect " << "incremental and per-window rolling to agree for window=" << windowSize
+                      << ", min_periods=" << minPeriods << ", center=" << center << ", symmetric=" << symmetric;
+                }
+            }
+        }
+    }
+}
+
+TEST(Series, rolling_incremental) {
+    arma::vec values = arma::linspace(0, 20, 50);
+    values.transform([](double val) { return 10 * std::sin(val) + 0.1; });
+    values(7) = NAN;
+    values(8) = NAN;
+    values(30) = NAN;
+    values(40) = values(38);
+    Series input(values, arma::linspace(1, 50, 50));
+
+    expect_incremental_matches_per_window(input, polars::Sum());
+    expect_incremental_matches_per_window(input, polars::Count());
+    expect_incremental_matches_per_window(input, polars::Mean());
+    expect_incremental_matches_per_window(input, polars::Std());
+    expect_incremental_matches_per_window(input, polars::RollingMin());
+    expect_incremental_matches_per_window(input, polars::RollingMax());
+    for (double q : {0., 0.2, 0.5, 0.75, 1.}) {
+        expect_incremental_matches_per_window(input, polars::Quantile(q));
+    }
+}
+
+
+template<class Processor>
+void expect_parallel_matches_serial(const Series &input, const Processor &processor) {
+    polars::ThreadPool pool(4);
+    for (arma::uword windowSize : {1, 4, 61}) {
+        for (bool symmetric : {true, false}) {
+            EXPECT_PRED2(
+                    Series::equal,
+                    input.rolling(windowSize, processor, 1, true, symmetric, polars::WindowProcessor::WindowType::none,
+                                  -1, &pool),
+                    input.rolling(windowSize, processor, 1, true, symmetric)
+            ) << "Expect " << "parallel and serial rolling to be identical for window=" << windowSize
+              << ", symmetric=" << symmetric;
+        }
+    }
+}
+
+TEST(Series, rolling_parallel) {
+    // Long enough to be split into several blocks.
+    arma::vec values = arma::linspace(0, 2000, 40000);
+    values.transform([](double val) { return 1e6 * std::sin(val) + 0.1; });
+    values.subvec(16000, 16500).fill(NAN);
+    Series input(values, arma::linspace(1, 40000, 40000));
+
+    expect_parallel_matches_serial(input, polars::Sum());
+    expect_parallel_matches_serial(input, polars::Mean());
+    expect_parallel_matches_serial(input, polars::Std());
+    expect_parallel_matches_serial(input, polars::RollingMax());
+    expect_parallel_matches_serial(input, polars::Quantile(0.3));
+    expect_parallel_matches_serial(input, PerWindow<polars::Mean>(polars::Mean()));
+
+    polars::ThreadPool pool(3);
+    EXPECT_PRED2(
+            Series::equal,
+            input.rolling(7, polars::Sum(), 0, true, false, polars::WindowProcessor::WindowType::triang, -1, &pool),
+            input.rolling(7, polars::Sum(), 0, true, false, polars::WindowProcessor::WindowType::triang)
+    ) << "Expect " << "weighted windows to be identical in parallel too";
+}
+
 TEST(Series, rolling_count_alignment){
 
     EXPECT_PRED2(
@@ -896,4 +997,86 @@ TEST(Series, rolling_mean_exponential_NAN) {
 }
 
 
+TEST(Series, rolling_mean_exponential_padded) {
+    Series input({1, NAN, NAN, 4, 5, 6}, {1, 2, 3, 4, 5, 6});
+    Series expected({1, 1, 1, 3.6666666666666665, 4.5199999999999996, 5.3508771929824563}, {1, 2, 3, 4, 5, 6});
+
+    EXPECT_PRED2(
+        Series::almost_equal,
+        input.rolling(4, polars::ExpMean(), 1, true, false, polars::WindowProcessor::WindowType::expn, 0.5),
+        expected
+    ) << "Expect " << "center to leave exponential windows where they were";
+
+    EXPECT_PRED2(
+        Series::almost_equal,
+        input.rolling(4, polars::ExpMean(), 1, false, false, polars::WindowProcessor::WindowType::expn, 0.5),
+        expected
+    ) << "Expect " << "the same without center";
+
+    arma::vec nans(7);
+    nans.fill(NAN);
+    EXPECT_PRED2(
+        Series::equal,
+        Series({NAN, NAN, 2, 3, NAN, 4, 5}, {1, 2, 3, 4, 5, 6, 7}).rolling(
+            4, polars::ExpMean(), 0, true, false, polars::WindowProcessor::WindowType::expn, 0.5),
+        Series(nans, {1, 2, 3, 4, 5, 6, 7})
+    ) << "Expect " << "minPeriods of 0 to still need every value of the series to be finite";
+
+    Series finite({1, 2, 3, 4}, {1, 2, 3, 4});
+    EXPECT_PRED2(
+        Series::almost_equal,
+        finite.rolling(2, 0, true, false, polars::WindowProcessor::WindowType::expn, 0.5).mean(),
+        finite.ewm(polars::Decay::alpha(0.5), true, false, 4).mean()
+    ) << "Expect " << "Window's default minPeriods to take the O(n) route, needing the whole series";
+    EXPECT_PRED2(
+        Series::almost_equal,
+        input.rolling(4, polars::ExpMean(), 3, false, false, polars::WindowProcessor::WindowType::expn, 0.5),
+        Series({NAN, NAN, NAN, NAN, 4.5199999999999996, 5.3508771929824563}, {1, 2, 3, 4, 5, 6})
+    ) << "Expect " << "results to wait for minPeriods finite values";
+}
+
+
+TEST(Series, rolling_offset) {
+    Series input({1, 2, NAN, 4, 5, 6}, {0, 1, 2, 5, 6, 10});
+
+    EXPECT_PRED2(Series::equal, input.rolling_offset(3).sum(), Series({1, 3, 3, 4, 9, 6}, {0, 1, 2, 5, 6, 10}))
+                        << "Expect " << "each window to cover the labels in (label - 3, label]";
+
+    EXPECT_PRED2(Series::equal, input.rolling_offset(3).count(), Series({1, 2, 2, 1, 2, 1}, {0, 1, 2, 5, 6, 10}))
+                        << "Expect " << "NANs not to be counted";
+
+    EXPECT_PRED2(Series::equal, input.rolling_offset(3, 2).max(), Series({NAN, 2, 2, NAN, 5, NAN}, {0, 1, 2, 5, 6, 10}))
+                        << "Expect " << "windows with fewer than min_periods finite values to be NAN";
+
+    EXPECT_PRED2(Series::equal, input.rolling_offset(0.5).mean(), Series({1, 2, NAN, 4, 5, 6}, {0, 1, 2, 5, 6, 10}))
+                        << "Expect " << "windows narrower than the sampling interval to hold a single value";
+
+    EXPECT_PRED2(Series::equal, Series({1, 2, 3}, {0, 0, 1}).rolling_offset(1).sum(), Series({1, 3, 3}, {0, 0, 1}))
+                        << "Expect " << "repeated labels to only include the values up to the current one";
+
+    for (double offset : {0.5, 1., 2., 3., 4., 100.}) {
+        EXPECT_PRED2(Series::almost_equal, input.rolling_offset(offset, polars::Quantile(0.3)),
+                     input.rolling_offset(offset, PerWindow<polars::Quantile>(polars::Quantile(0.3))))
+                            << "Expect " << "incremental and per-window rolling to agree for offset=" << offset;
+        EXPECT_PRED2(Series::almost_equal, input.rolling_offset(offset, polars::Std()),
+                     input.rolling_offset(offset, PerWindow<polars::Std>(polars::Std())))
+                            << "Expect " << "incremental and per-window rolling to agree for offset=" << offset;
+    }
+
+    Series gaps({1, NAN, NAN, 4}, {0, 5, 6, 10});
+    EXPECT_PRED2(Series::equal, gaps.rolling_offset(2, 0).count(), Series({1, 0, 0, 1}, {0, 5, 6, 10}))
+                        << "Expect " << "windows of only NANs to count 0 when min_periods is 0";
+    EXPECT_PRED2(Series::equal, gaps.rolling_offset(2, 0).sum(), Series({1, 0, 0, 4}, {0, 5, 6, 10}));
+    EXPECT_PRED2(Series::equal, gaps.rolling_offset(2, 0).mean(), Series({1, NAN, NAN, 4}, {0, 5, 6, 10}));
+    EXPECT_PRED2(Series::equal, gaps.rolling_offset(2, polars::Count(-1)), Series({1, -1, -1, 1}, {0, 5, 6, 10}))
+                        << "Expect " << "min_periods 1 to still use the default value";
+
+    EXPECT_PRED2(Series::equal, Series().rolling_offset(3).sum(), Series())
+                        << "Expect " << "empty Series stays empty";
+
+    EXPECT_THROW(Series({1, 2}, {2, 1}).rolling_offset(3).sum(), std::invalid_argument)
+                        << "Expect " << "an unsorted index to be rejected";
+}
+
+
 } // namespace SeriesTests
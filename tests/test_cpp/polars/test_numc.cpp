@@ -39,6 +39,33 @@ TEST(numc, sum_finite){
     EXPECT_EQ(arma::sum(arma::vec({1, 2, 3})), polars::numc::sum_finite(arma::vec({1, 2, 3})))
                         << "Expect " << " same result as sum because no NANs";
     EXPECT_EQ(3, polars::numc::sum_finite(arma::vec({1,2,NAN}))) << "Expect " << " sum of first two terms";
+    EXPECT_EQ(3, polars::numc::sum_finite(arma::vec({1, 2, INFINITY, -INFINITY}))) << "Expect " << " infinities skipped";
+}
+
+TEST(numc, moments_finite){
+    // Long enough to use every lane and leave a remainder, with non-finite values scattered through it.
+    arma::vec x(37);
+    for (arma::uword i = 0; i < x.n_elem; i++) {
+        x[i] = i % 5 == 0 ? NAN : std::sin(i) * 100 + i;
+    }
+    x[12] = INFINITY;
+    arma::vec finites = x.elem(arma::find_finite(x));
+
+    EXPECT_EQ(polars::numc::count_finite(x), finites.n_elem) << "Expect " << " NANs and infinities not counted";
+
+    polars::numc::FiniteSum sum = polars::numc::sum_count_finite(x);
+    EXPECT_EQ(sum.count, finites.n_elem) << "Expect " << " count of finite values";
+    EXPECT_DOUBLE_EQ(sum.sum, arma::sum(finites)) << "Expect " << " sum of finite values";
+
+    polars::numc::FiniteMoments moments = polars::numc::moments_finite(x);
+    EXPECT_EQ(moments.count, finites.n_elem) << "Expect " << " count of finite values";
+    EXPECT_DOUBLE_EQ(moments.mean, arma::mean(finites)) << "Expect " << " mean of finite values";
+    EXPECT_DOUBLE_EQ(moments.m2, arma::sum(arma::square(finites - arma::mean(finites))))
+                        << "Expect " << " squared deviations of finite values";
+
+    polars::numc::FiniteMoments empty = polars::numc::moments_finite(arma::vec({NAN}));
+    EXPECT_EQ(empty.count, 0) << "Expect " << " no finite values";
+    EXPECT_EQ(empty.m2, 0) << "Expect " << " no deviations without finite values";
 }
 
 TEST(numc, triang){